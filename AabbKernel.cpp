@@ -0,0 +1,114 @@
+#include "AabbKernel.h"
+#include <cmath>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define AABB_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define AABB_SSE2
+#endif
+
+// The scalar tests compute |dx| - (w + w') / 2 < 0. That has the sign of |dx| < (w + w') / 2,
+// and halving is exact, so (w + w') / 2 == w / 2 + w' / 2: comparing against summed
+// half-extents gives the same answer bit for bit.
+
+// ————— LANE OPERATIONS ————— //
+#if defined(AABB_AVX2)
+struct BoxLanes
+{
+    typedef __m256 V;
+    static constexpr int WIDTH = 8;
+
+    static V load(const float* p)  { return _mm256_loadu_ps(p); }
+    static V set(float x)          { return _mm256_set1_ps(x); }
+    static V sub(V a, V b)         { return _mm256_sub_ps(a, b); }
+    static V add(V a, V b)         { return _mm256_add_ps(a, b); }
+    static V abs(V a)              { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static V less(V a, V b)        { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V both(V a, V b)        { return _mm256_and_ps(a, b); }
+    static unsigned bits(V mask)   { return (unsigned)_mm256_movemask_ps(mask); }
+};
+#elif defined(AABB_SSE2)
+struct BoxLanes
+{
+    typedef __m128 V;
+    static constexpr int WIDTH = 4;
+
+    static V load(const float* p)  { return _mm_loadu_ps(p); }
+    static V set(float x)          { return _mm_set1_ps(x); }
+    static V sub(V a, V b)         { return _mm_sub_ps(a, b); }
+    static V add(V a, V b)         { return _mm_add_ps(a, b); }
+    static V abs(V a)              { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static V less(V a, V b)        { return _mm_cmplt_ps(a, b); }
+    static V both(V a, V b)        { return _mm_and_ps(a, b); }
+    static unsigned bits(V mask)   { return (unsigned)_mm_movemask_ps(mask); }
+};
+#endif
+
+void aabb_overlap_masks(float x, float y, float half_width, float half_height,
+                        const float* center_x, const float* center_y,
+                        const float* half_widths, const float* half_heights,
+                        int count, std::uint32_t* masks)
+{
+    for (int w = 0; w < aabb_mask_words(count); w++) masks[w] = 0;
+
+    int i = 0;
+
+#if defined(AABB_AVX2) || defined(AABB_SSE2)
+    typedef BoxLanes L;
+    typedef L::V V;
+
+    const V query_x = L::set(x), query_y = L::set(y);
+    const V query_half_width = L::set(half_width), query_half_height = L::set(half_height);
+
+    // WIDTH divides 32, so a register's bits never straddle two mask words
+    for (; i + L::WIDTH <= count; i += L::WIDTH)
+    {
+        V x_hit = L::less(L::abs(L::sub(query_x, L::load(center_x + i))), L::add(query_half_width, L::load(half_widths + i)));
+        V y_hit = L::less(L::abs(L::sub(query_y, L::load(center_y + i))), L::add(query_half_height, L::load(half_heights + i)));
+        masks[i / 32] |= (std::uint32_t)L::bits(L::both(x_hit, y_hit)) << (i % 32);
+    }
+#endif
+
+    // Whatever doesn't fill a whole register
+    for (; i < count; i++)
+    {
+        bool hit = std::fabs(x - center_x[i]) < half_width + half_widths[i] &&
+                   std::fabs(y - center_y[i]) < half_height + half_heights[i];
+        if (hit) masks[i / 32] |= 1u << (i % 32);
+    }
+}
+
+// ————— PACKED COLLIDERS ————— //
+void PackedColliders::clear()
+{
+    m_center_x.clear();
+    m_center_y.clear();
+    m_half_width.clear();
+    m_half_height.clear();
+}
+
+void PackedColliders::add(glm::vec3 position, float width, float height)
+{
+    m_center_x.push_back(position.x);
+    m_center_y.push_back(position.y);
+    m_half_width.push_back(width / 2.0f);
+    m_half_height.push_back(height / 2.0f);
+}
+
+void PackedColliders::set(int index, glm::vec3 position, float width, float height)
+{
+    m_center_x[index] = position.x;
+    m_center_y[index] = position.y;
+    m_half_width[index] = width / 2.0f;
+    m_half_height[index] = height / 2.0f;
+}
+
+void PackedColliders::overlap_masks(glm::vec3 position, float width, float height, int first, std::uint32_t* masks) const
+{
+    aabb_overlap_masks(position.x, position.y, width / 2.0f, height / 2.0f,
+                       m_center_x.data() + first, m_center_y.data() + first,
+                       m_half_width.data() + first, m_half_height.data() + first,
+                       get_count() - first, masks);
+}
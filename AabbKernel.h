@@ -0,0 +1,62 @@
+#ifndef AABB_KERNEL_H
+#define AABB_KERNEL_H
+
+// Batched box overlap tests. One query box is tested against packed arrays of
+// centres and half-extents, 8 boxes per instruction with AVX2 (/arch:AVX2 or
+// -mavx2) or 4 with SSE2, and the hits come back as a bitmask. A hit is decided
+// exactly as Entity::check_collision and sim_check_collision decide it.
+#include "glm/glm.hpp"
+#include <cstdint>
+#include <vector>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+// Sets bit (i % 32) of masks[i / 32] when box i overlaps the query, for every i < count.
+// masks needs (count + 31) / 32 words.
+void aabb_overlap_masks(float x, float y, float half_width, float half_height,
+                        const float* center_x, const float* center_y,
+                        const float* half_widths, const float* half_heights,
+                        int count, std::uint32_t* masks);
+
+inline int aabb_mask_words(int count) { return (count + 31) / 32; }
+
+// Index of the lowest set bit; mask must not be 0
+inline int aabb_lowest_hit(std::uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Boxes stored the way aabb_overlap_masks() reads them
+class PackedColliders
+{
+private:
+    std::vector<float> m_center_x, m_center_y;
+    std::vector<float> m_half_width, m_half_height;
+
+public:
+    // ————— METHODS ————— //
+    void clear();
+    void add(glm::vec3 position, float width, float height);
+    void set(int index, glm::vec3 position, float width, float height);
+
+    // Hit masks for boxes [first, get_count()) against a box the size of an entity;
+    // bit 0 of masks[0] is box first
+    void overlap_masks(glm::vec3 position, float width, float height, int first, std::uint32_t* masks) const;
+
+    // ————— GETTERS ————— //
+    int get_count() const { return (int)m_center_x.size(); }
+    const float* get_center_x()    const { return m_center_x.data(); }
+    const float* get_center_y()    const { return m_center_y.data(); }
+    const float* get_half_width()  const { return m_half_width.data(); }
+    const float* get_half_height() const { return m_half_height.data(); }
+};
+
+#endif // AABB_KERNEL_H
@@ -0,0 +1,16 @@
+#ifndef COLLISION_LAYERS_H
+#define COLLISION_LAYERS_H
+
+// Collision filtering by layer. Every body has a category, the layers it's on (one
+// bit each), and a mask, the layers it collides with. A pair is only tested when
+// each is on a layer the other collides with, and that's checked before any
+// geometry, so pairs that can never interact cost two ANDs.
+constexpr unsigned LAYER_NONE = 0u,
+                   LAYER_ALL  = ~0u;
+
+inline bool layers_collide(unsigned category, unsigned mask, unsigned other_category, unsigned other_mask)
+{
+    return (category & other_mask) != 0 && (other_category & mask) != 0;
+}
+
+#endif // COLLISION_LAYERS_H
@@ -0,0 +1,20 @@
+#ifndef CONTACT_H
+#define CONTACT_H
+
+// What the collision stage found this tick, worked out once per touching pair so
+// the game rules and anything else that cares (telemetry, sound) read the same
+// list instead of running the narrowphase again.
+#include "glm/glm.hpp"
+#include <vector>
+
+struct Contact
+{
+    int       a, b;              // The body that moved into the other, and the one it touched
+    glm::vec3 normal;            // Unit vector out of b, the way a is (or was) pushed to separate them
+    float     depth;             // How far a is into b along normal
+    glm::vec3 relative_velocity; // a's velocity minus b's, as they met
+};
+
+typedef std::vector<Contact> ContactList;
+
+#endif // CONTACT_H
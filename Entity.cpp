@@ -12,6 +12,15 @@
 #include "glm/gtc/matrix_transform.hpp"
 #include "ShaderProgram.h"
 #include "Entity.h"
+#include "UniformGrid.h"
+#include "StaticBvh.h"
+#include "AabbKernel.h"
+#include "Integrator.h"
+#include <algorithm>
+#include <vector>
+
+// The hot cache line and two for the rest; see the layout notes in Entity.h
+static_assert(sizeof(Entity) == 192, "Entity has outgrown its three cache lines");
 
 void Entity::ai_activate(Entity *player)
 {
@@ -59,9 +68,9 @@ void Entity::ai_guard(Entity *player)
 }
 // Default constructor
 Entity::Entity()
-    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f), m_model_matrix(1.0f),
+    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f),
     m_speed(0.0f), m_animation_cols(0), m_animation_frames(0), m_animation_index(0),
-    m_animation_rows(0), m_animation_indices(nullptr), m_animation_time(0.0f),
+    m_animation_rows(0), m_animation_time(0.0f),
     m_texture_id(0), m_velocity(0.0f), m_acceleration(0.0f), m_width(0.0f), m_height(0.0f)
 {
     // Initialize m_walking with zeros or any default value
@@ -73,33 +82,38 @@ Entity::Entity()
 Entity::Entity(GLuint texture_id, float speed, glm::vec3 acceleration, float jump_power, int walking[4][4], float animation_time,
     int animation_frames, int animation_index, int animation_cols,
     int animation_rows, float width, float height, EntityType EntityType)
-    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f), m_model_matrix(1.0f),
+    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f),
     m_speed(speed),m_acceleration(acceleration), m_jumping_power(jump_power), m_animation_cols(animation_cols),
     m_animation_frames(animation_frames), m_animation_index(animation_index),
-    m_animation_rows(animation_rows), m_animation_indices(nullptr),
+    m_animation_rows(animation_rows),
     m_animation_time(animation_time), m_texture_id(texture_id), m_velocity(0.0f),
     m_width(width), m_height(height), m_entity_type(EntityType)
 {
+    set_entity_type(m_entity_type);
     face_right();
     set_walking(walking);
 }
 
 // Simpler constructor for partial initialization
 Entity::Entity(GLuint texture_id, float speed,  float width, float height, EntityType EntityType)
-    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f), m_model_matrix(1.0f),
+    : m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f),
     m_speed(speed), m_animation_cols(0), m_animation_frames(0), m_animation_index(0),
-    m_animation_rows(0), m_animation_indices(nullptr), m_animation_time(0.0f),
+    m_animation_rows(0), m_animation_time(0.0f),
     m_texture_id(texture_id), m_velocity(0.0f), m_acceleration(0.0f), m_width(width), m_height(height),m_entity_type(EntityType)
 {
+    set_entity_type(m_entity_type);
+
     // Initialize m_walking with zeros or any default value
     for (int i = 0; i < SECONDS_PER_FRAME; ++i)
         for (int j = 0; j < SECONDS_PER_FRAME; ++j) m_walking[i][j] = 0;
 }
-Entity::Entity(GLuint texture_id, float speed, float width, float height, EntityType EntityType, AIType AIType, AIState AIState): m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f), m_model_matrix(1.0f),
+Entity::Entity(GLuint texture_id, float speed, float width, float height, EntityType EntityType, AIType AIType, AIState AIState): m_position(0.0f), m_movement(0.0f), m_scale(1.0f, 1.0f, 0.0f),
 m_speed(speed), m_animation_cols(0), m_animation_frames(0), m_animation_index(0),
-m_animation_rows(0), m_animation_indices(nullptr), m_animation_time(0.0f),
+m_animation_rows(0), m_animation_time(0.0f),
 m_texture_id(texture_id), m_velocity(0.0f), m_acceleration(0.0f), m_width(width), m_height(height),m_entity_type(EntityType), m_ai_type(AIType), m_ai_state(AIState)
 {
+set_entity_type(m_entity_type);
+
 // Initialize m_walking with zeros or any default value
 for (int i = 0; i < SECONDS_PER_FRAME; ++i)
     for (int j = 0; j < SECONDS_PER_FRAME; ++j) m_walking[i][j] = 0;
@@ -153,68 +167,213 @@ bool const Entity::check_collision(Entity* other) const
     return x_distance < 0.0f && y_distance < 0.0f;
 }
 
+void Entity::add_contact(int collidable_index, const Entity* collidable_entity, glm::vec3 normal, float depth)
+{
+    Contact contact;
+    contact.a = m_contact_index;
+    contact.b = collidable_index;
+    contact.normal = normal;
+    contact.depth = depth;
+    contact.relative_velocity = m_velocity - collidable_entity->m_velocity;
+    m_contacts->push_back(contact);
+}
+
+bool Entity::resolve_collision_y(Entity* collidable_entity, int index)
+{
+    if (!collides_with(collidable_entity) || !check_collision(collidable_entity)) return false;
+
+    float y_distance = fabs(m_position.y - collidable_entity->m_position.y);
+    float y_overlap = fabs(y_distance - (m_height / 2.0f) - (collidable_entity->m_height / 2.0f));
+    if (m_velocity.y > 0)
+    {
+        if (m_contacts) add_contact(index, collidable_entity, glm::vec3(0.0f, -1.0f, 0.0f), y_overlap);
+        m_position.y   -= y_overlap;
+        m_velocity.y    = 0;
+
+        // Collision!
+        m_collided_top  = true;
+        return true;
+    } else if (m_velocity.y < 0)
+    {
+        if (m_contacts) add_contact(index, collidable_entity, glm::vec3(0.0f, 1.0f, 0.0f), y_overlap);
+        m_position.y      += y_overlap;
+        m_velocity.y       = 0;
+
+        // Collision!
+        m_collided_bottom  = true;
+        return true;
+    }
+    return false;
+}
+
+bool Entity::resolve_collision_x(Entity* collidable_entity, int index)
+{
+    if (!collides_with(collidable_entity) || !check_collision(collidable_entity)) return false;
+
+    float x_distance = fabs(m_position.x - collidable_entity->m_position.x);
+    float x_overlap = fabs(x_distance - (m_width / 2.0f) - (collidable_entity->m_width / 2.0f));
+    if (m_velocity.x > 0)
+    {
+        if (m_contacts) add_contact(index, collidable_entity, glm::vec3(-1.0f, 0.0f, 0.0f), x_overlap);
+        m_position.x     -= x_overlap;
+        m_velocity.x      = 0;
+
+        // Collision!
+        m_collided_right  = true;
+        return true;
+
+    } else if (m_velocity.x < 0)
+    {
+        if (m_contacts) add_contact(index, collidable_entity, glm::vec3(1.0f, 0.0f, 0.0f), x_overlap);
+        m_position.x    += x_overlap;
+        m_velocity.x     = 0;
+
+        // Collision!
+        m_collided_left  = true;
+        return true;
+    }
+    return false;
+}
+
 void const Entity::check_collision_y(Entity *collidable_entities, int collidable_entity_count)
 {
     for (int i = 0; i < collidable_entity_count; i++)
     {
-        Entity *collidable_entity = &collidable_entities[i];
+        resolve_collision_y(&collidable_entities[i], i);
+    }
+}
+
+void const Entity::check_collision_x(Entity *collidable_entities, int collidable_entity_count)
+{
+    for (int i = 0; i < collidable_entity_count; i++)
+    {
+        resolve_collision_x(&collidable_entities[i], i);
+    }
+}
 
-        if (check_collision(collidable_entity))
+// Same results as the full scans above, in the same order, but only visiting the
+// grid's candidates. Being pushed out of one entity can move us next to others
+// that weren't candidates, so the candidates are looked up again after every push.
+void const Entity::check_collision_y(Entity *collidable_entities, const UniformGrid& broadphase)
+{
+    static thread_local std::vector<int> candidates;
+    broadphase.query_static(m_position, m_width, m_height, candidates);
+
+    for (size_t c = 0; c < candidates.size(); c++)
+    {
+        int i = candidates[c];
+        if (resolve_collision_y(&collidable_entities[i], i))
         {
-            float y_distance = fabs(m_position.y - collidable_entity->m_position.y);
-            float y_overlap = fabs(y_distance - (m_height / 2.0f) - (collidable_entity->m_height / 2.0f));
-            if (m_velocity.y > 0)
-            {
-                m_position.y   -= y_overlap;
-                m_velocity.y    = 0;
+            broadphase.query_static(m_position, m_width, m_height, candidates);
+            c = std::upper_bound(candidates.begin(), candidates.end(), i) - candidates.begin() - 1;
+        }
+    }
+}
 
-                // Collision!
-                m_collided_top  = true;
-            } else if (m_velocity.y < 0)
-            {
-                m_position.y      += y_overlap;
-                m_velocity.y       = 0;
+void const Entity::check_collision_x(Entity *collidable_entities, const UniformGrid& broadphase)
+{
+    static thread_local std::vector<int> candidates;
+    broadphase.query_static(m_position, m_width, m_height, candidates);
 
-                // Collision!
-                m_collided_bottom  = true;
-            }
+    for (size_t c = 0; c < candidates.size(); c++)
+    {
+        int i = candidates[c];
+        if (resolve_collision_x(&collidable_entities[i], i))
+        {
+            broadphase.query_static(m_position, m_width, m_height, candidates);
+            c = std::upper_bound(candidates.begin(), candidates.end(), i) - candidates.begin() - 1;
         }
     }
 }
 
-void const Entity::check_collision_x(Entity *collidable_entities, int collidable_entity_count)
+// The BVH's hits are exact, so there's nothing to narrow down; otherwise as above
+void const Entity::check_collision_y(Entity *collidable_entities, const StaticBvh& level)
 {
-    for (int i = 0; i < collidable_entity_count; i++)
+    static thread_local std::vector<int> hits;
+    level.query_box(m_position, m_width, m_height, hits);
+
+    for (size_t h = 0; h < hits.size(); h++)
+    {
+        int i = hits[h];
+        if (resolve_collision_y(&collidable_entities[i], i))
+        {
+            level.query_box(m_position, m_width, m_height, hits);
+            h = std::upper_bound(hits.begin(), hits.end(), i) - hits.begin() - 1;
+        }
+    }
+}
+
+void const Entity::check_collision_x(Entity *collidable_entities, const StaticBvh& level)
+{
+    static thread_local std::vector<int> hits;
+    level.query_box(m_position, m_width, m_height, hits);
+
+    for (size_t h = 0; h < hits.size(); h++)
     {
-        Entity *collidable_entity = &collidable_entities[i];
+        int i = hits[h];
+        if (resolve_collision_x(&collidable_entities[i], i))
+        {
+            level.query_box(m_position, m_width, m_height, hits);
+            h = std::upper_bound(hits.begin(), hits.end(), i) - hits.begin() - 1;
+        }
+    }
+}
+
+// Same again against packed copies of collidable_entities, many boxes per test. Hits
+// are resolved lowest index first; after a push, everything past the entity that
+// pushed us is tested again from our new position.
+void const Entity::check_collision_y(Entity *collidable_entities, const PackedColliders& colliders)
+{
+    static thread_local std::vector<std::uint32_t> masks;
+    int first = 0;
 
-        if (check_collision(collidable_entity))
+    while (first < colliders.get_count())
+    {
+        masks.resize(aabb_mask_words(colliders.get_count() - first));
+        colliders.overlap_masks(m_position, m_width, m_height, first, masks.data());
+
+        int pushed_by = -1;
+        for (size_t w = 0; w < masks.size() && pushed_by < 0; w++)
         {
-            float x_distance = fabs(m_position.x - collidable_entity->m_position.x);
-            float x_overlap = fabs(x_distance - (m_width / 2.0f) - (collidable_entity->m_width / 2.0f));
-            if (m_velocity.x > 0)
+            for (std::uint32_t hits = masks[w]; hits != 0; hits &= hits - 1)
             {
-                m_position.x     -= x_overlap;
-                m_velocity.x      = 0;
+                int i = first + (int)w * 32 + aabb_lowest_hit(hits);
+                if (resolve_collision_y(&collidable_entities[i], i)) { pushed_by = i; break; }
+            }
+        }
 
-                // Collision!
-                m_collided_right  = true;
+        if (pushed_by < 0) return;
+        first = pushed_by + 1;
+    }
+}
 
-            } else if (m_velocity.x < 0)
-            {
-                m_position.x    += x_overlap;
-                m_velocity.x     = 0;
+void const Entity::check_collision_x(Entity *collidable_entities, const PackedColliders& colliders)
+{
+    static thread_local std::vector<std::uint32_t> masks;
+    int first = 0;
+
+    while (first < colliders.get_count())
+    {
+        masks.resize(aabb_mask_words(colliders.get_count() - first));
+        colliders.overlap_masks(m_position, m_width, m_height, first, masks.data());
 
-                // Collision!
-                m_collided_left  = true;
+        int pushed_by = -1;
+        for (size_t w = 0; w < masks.size() && pushed_by < 0; w++)
+        {
+            for (std::uint32_t hits = masks[w]; hits != 0; hits &= hits - 1)
+            {
+                int i = first + (int)w * 32 + aabb_lowest_hit(hits);
+                if (resolve_collision_x(&collidable_entities[i], i)) { pushed_by = i; break; }
             }
         }
+
+        if (pushed_by < 0) return;
+        first = pushed_by + 1;
     }
 }
-void Entity::update(float delta_time, Entity* player, Entity* collidable_entities, int collidable_entity_count)
-{
-    if (!m_is_active) return;
 
+void Entity::begin_update(float delta_time, Entity* player)
+{
     m_collided_top = false;
     m_collided_bottom = false;
     m_collided_left = false;
@@ -222,7 +381,7 @@ void Entity::update(float delta_time, Entity* player, Entity* collidable_entitie
 
     if (m_entity_type == ENEMY) ai_activate(player);
 
-    if (m_animation_indices != NULL)
+    if (m_facing >= 0)
     {
         if (glm::length(m_movement) != 0)
         {
@@ -241,20 +400,41 @@ void Entity::update(float delta_time, Entity* player, Entity* collidable_entitie
             }
         }
     }
+}
 
-    // Apply acceleration to velocity first
-    m_velocity += m_acceleration * delta_time;
+glm::vec3 Entity::get_integration_velocity() const
+{
+    // Walking sets the horizontal speed outright, whatever the acceleration
+    glm::vec3 velocity = m_velocity;
+    if (glm::length(m_movement) > 0) velocity.x = m_movement.x * m_speed;
+    return velocity;
+}
 
-    if (glm::length(m_movement) > 0) {
-        m_velocity.x = m_movement.x * m_speed;
-    }
+glm::vec3 Entity::get_integration_acceleration() const
+{
+    glm::vec3 acceleration = m_acceleration;
+    if (glm::length(m_movement) > 0) acceleration.x = 0.0f;
+    return acceleration;
+}
 
-    // Update position based on velocity
-    m_position.y += m_velocity.y * delta_time;
-    check_collision_y(collidable_entities, collidable_entity_count);
+void Entity::finish_update(glm::vec3 position, glm::vec3 velocity, Entity* collidable_entities, int collidable_entity_count,
+                           const UniformGrid* broadphase, ContactList* contacts, int contact_index)
+{
+    m_contacts = contacts;
+    m_contact_index = contact_index;
 
-    m_position.x += m_velocity.x * delta_time;
-    check_collision_x(collidable_entities, collidable_entity_count);
+    m_velocity.x = velocity.x;
+    m_velocity.y = velocity.y;
+
+    // The integrator moved both axes at once; collisions are still resolved y first, then x
+    float end_x = position.x;
+    m_position.y = position.y;
+    if (broadphase) check_collision_y(collidable_entities, *broadphase);
+    else            check_collision_y(collidable_entities, collidable_entity_count);
+
+    m_position.x = end_x;
+    if (broadphase) check_collision_x(collidable_entities, *broadphase);
+    else            check_collision_x(collidable_entities, collidable_entity_count);
 
     if (m_is_jumping)
     {
@@ -262,18 +442,62 @@ void Entity::update(float delta_time, Entity* player, Entity* collidable_entitie
         m_velocity.y += m_jumping_power;
     }
 
-    m_model_matrix = glm::mat4(1.0f);
-    m_model_matrix = glm::translate(m_model_matrix, m_position);
+    m_contacts = nullptr;
+}
+
+void Entity::update(float delta_time, Entity* player, Entity* collidable_entities, int collidable_entity_count,
+                    const UniformGrid* broadphase, ContactList* contacts, int contact_index)
+{
+    if (!m_is_active) return;
+
+    begin_update(delta_time, player);
+
+    glm::vec3 position = m_position;
+    glm::vec3 velocity = get_integration_velocity();
+    glm::vec3 acceleration = get_integration_acceleration();
+    AxisStep step = axis_step(delta_time);
+    integrate_axis<ScalarLanes>(INTEGRATOR_SEMI_IMPLICIT_EULER, step, position.x, velocity.x, acceleration.x);
+    integrate_axis<ScalarLanes>(INTEGRATOR_SEMI_IMPLICIT_EULER, step, position.y, velocity.y, acceleration.y);
+
+    finish_update(position, velocity, collidable_entities, collidable_entity_count, broadphase, contacts, contact_index);
+}
+
+void Entity::update_all(Entity* entities, int entity_count, BodyBatch& bodies, IntegratorKind kind, float delta_time,
+                        Entity* player, Entity* collidable_entities, int collidable_entity_count,
+                        const UniformGrid* broadphase, ContactList* contacts)
+{
+    // Inactive entities ride along in the batch untouched, so indices stay the same
+    bodies.resize(entity_count);
+    for (int i = 0; i < entity_count; i++)
+    {
+        Entity& entity = entities[i];
+        if (entity.m_is_active) entity.begin_update(delta_time, player);
+        bodies.set(i, entity.m_position, entity.get_integration_velocity(), entity.get_integration_acceleration());
+    }
+
+    AxisStep step = axis_step(delta_time);
+    bodies.integrate(kind, step, step);
+
+    for (int i = 0; i < entity_count; i++)
+    {
+        if (!entities[i].m_is_active) continue;
+
+        glm::vec3 position = bodies.get_position(i);
+        position.z = entities[i].m_position.z;
+        entities[i].finish_update(position, bodies.get_velocity(i), collidable_entities, collidable_entity_count, broadphase,
+                                  contacts, i);
+    }
 }
 
 
 void Entity::render(ShaderProgram* program)
 {
-    program->set_model_matrix(m_model_matrix);
+    // Built here rather than kept: only rendering needs it, and it's a whole cache line
+    program->set_model_matrix(glm::translate(glm::mat4(1.0f), m_position));
 
-    if (m_animation_indices != NULL)
+    if (m_facing >= 0)
     {
-        draw_sprite_from_texture_atlas(program, m_texture_id, m_animation_indices[m_animation_index]);
+        draw_sprite_from_texture_atlas(program, m_texture_id, m_walking[m_facing][m_animation_index]);
         return;
     }
 
@@ -3,38 +3,65 @@
 
 #include "glm/glm.hpp"
 #include "ShaderProgram.h"
-enum EntityType { PLATFORM, PLAYER, ENEMY  };
+#include "Integrator.h"
+#include "Contact.h"
+#include "EntityType.h"
+#include <cstdint>
+
+class UniformGrid;
+class StaticBvh;
+class PackedColliders;
+
 enum AIType     { WALKER, GUARD            };
 enum AIState    { WALKING, IDLE, ATTACKING };
 
 
 enum AnimationDirection { LEFT, RIGHT, UP, DOWN };
 
-class Entity
+// Laid out hot first: everything a collision scan reads, of the entity moving and of
+// the ones it's tested against, sits in the first cache line, and the rest of the
+// object is only read by update() and render(). Entities are cache-line aligned so
+// that line is never split, and kept to three lines in all.
+class alignas(64) Entity
 {
 private:
-    bool m_is_active = true;
+    // ————— COLLISIONS (HOT) ————— //
+    // What check_collision() reads of the other entity comes first
+    glm::vec3 m_position;
+    float     m_width = 1.0f,
+              m_height = 1.0f;
 
-    int m_walking[4][4]; // 4x4 array for walking animations
+    // Untyped entities collide with everything; set_entity_type() puts them on their type's layer
+    unsigned m_collision_category = LAYER_ALL,
+             m_collision_mask     = LAYER_ALL;
 
+    glm::vec3 m_velocity;
+
+    // Where this update's contacts go (none if null), and this entity's number in them
+    ContactList* m_contacts = nullptr;
+    int          m_contact_index = 0;
 
     EntityType m_entity_type;
-    AIType     m_ai_type;
-    AIState    m_ai_state;
+
+    bool m_is_active = true;
+    bool m_collided_top    = false;
+    bool m_collided_bottom = false;
+    bool m_collided_left   = false;
+    bool m_collided_right  = false;
+
     // ————— TRANSFORMATIONS ————— //
+    glm::vec3 m_acceleration;
     glm::vec3 m_movement;
-    glm::vec3 m_position;
     glm::vec3 m_scale;
-    glm::vec3 m_velocity;
-    glm::vec3 m_acceleration;
-
-    glm::mat4 m_model_matrix;
 
     float     m_speed,
               m_jumping_power;
 
     bool m_is_jumping;
 
+    AIType     m_ai_type;
+    AIState    m_ai_state;
+
     // ————— TEXTURES ————— //
     GLuint    m_texture_id;
 
@@ -44,16 +71,23 @@ private:
         m_animation_index,
         m_animation_rows;
 
-    int* m_animation_indices = nullptr;
+    int   m_facing = -1; // Row of m_walking being played (an AnimationDirection), or -1 for none
     float m_animation_time = 0.0f;
 
-    float m_width = 1.0f,
-          m_height = 1.0f;
-    // ————— COLLISIONS ————— //
-    bool m_collided_top    = false;
-    bool m_collided_bottom = false;
-    bool m_collided_left   = false;
-    bool m_collided_right  = false;
+    std::int16_t m_walking[4][4]; // 4x4 array for walking animations, atlas frame numbers
+
+    // Pushes this entity out of one other entity along an axis; true if it moved.
+    // index is the other entity's number in this update's contacts.
+    bool resolve_collision_y(Entity* collidable_entity, int index);
+    bool resolve_collision_x(Entity* collidable_entity, int index);
+    void add_contact(int collidable_index, const Entity* collidable_entity, glm::vec3 normal, float depth);
+
+    // update() around the integrator: AI and animation before it, collisions and jumps after
+    void begin_update(float delta_time, Entity* player);
+    glm::vec3 get_integration_velocity() const;
+    glm::vec3 get_integration_acceleration() const;
+    void finish_update(glm::vec3 position, glm::vec3 velocity, Entity* collidable_entities, int collidable_entity_count,
+                       const UniformGrid* broadphase, ContactList* contacts, int contact_index);
 
 public:
     // ————— STATIC VARIABLES ————— //
@@ -71,9 +105,38 @@ public:
     void draw_sprite_from_texture_atlas(ShaderProgram* program, GLuint texture_id, int index);
     bool const check_collision(Entity* other) const;
 
+    // Whether the two entities' layers let them collide at all, before any geometry
+    bool collides_with(const Entity* other) const
+    {
+        return layers_collide(m_collision_category, m_collision_mask, other->m_collision_category, other->m_collision_mask);
+    }
+
     void const check_collision_y(Entity* collidable_entities, int collidable_entity_count);
     void const check_collision_x(Entity* collidable_entities, int collidable_entity_count);
-    void update(float delta_time, Entity *player, Entity *collidable_entities, int collidable_entity_count);
+
+    // Broadphase versions: broadphase holds collidable_entities as its static boxes, in array order
+    void const check_collision_y(Entity* collidable_entities, const UniformGrid& broadphase);
+    void const check_collision_x(Entity* collidable_entities, const UniformGrid& broadphase);
+
+    // BVH versions: level holds collidable_entities as its boxes, in array order
+    void const check_collision_y(Entity* collidable_entities, const StaticBvh& level);
+    void const check_collision_x(Entity* collidable_entities, const StaticBvh& level);
+
+    // SIMD versions: colliders holds packed copies of collidable_entities, in array order
+    void const check_collision_y(Entity* collidable_entities, const PackedColliders& colliders);
+    void const check_collision_x(Entity* collidable_entities, const PackedColliders& colliders);
+
+    // Pushes out of collidable_entities are added to contacts, if given, with this entity
+    // as body contact_index and what it hit numbered by its place in collidable_entities
+    void update(float delta_time, Entity *player, Entity *collidable_entities, int collidable_entity_count,
+                const UniformGrid* broadphase = nullptr, ContactList* contacts = nullptr, int contact_index = 0);
+
+    // update() for every entity in the array, with all of them integrated together in
+    // one pass over bodies (scratch space, kept by the caller between ticks). Contacts
+    // number each entity by its place in entities.
+    static void update_all(Entity* entities, int entity_count, BodyBatch& bodies, IntegratorKind kind, float delta_time,
+                           Entity* player, Entity* collidable_entities, int collidable_entity_count,
+                           const UniformGrid* broadphase = nullptr, ContactList* contacts = nullptr);
     void render(ShaderProgram* program);
 
     void ai_activate(Entity *player);
@@ -82,10 +145,10 @@ public:
 
     void normalise_movement() { m_movement = glm::normalize(m_movement); }
 
-    void face_left() { m_animation_indices = m_walking[LEFT]; }
-    void face_right() { m_animation_indices = m_walking[RIGHT]; }
-    void face_up() { m_animation_indices = m_walking[UP]; }
-    void face_down() { m_animation_indices = m_walking[DOWN]; }
+    void face_left() { m_facing = LEFT; }
+    void face_right() { m_facing = RIGHT; }
+    void face_up() { m_facing = UP; }
+    void face_down() { m_facing = DOWN; }
 
     void move_left() { m_movement.x = -1.0f; face_left(); }
     void move_right() { m_movement.x = 1.0f;  face_right(); }
@@ -111,11 +174,21 @@ public:
     bool      const get_collided_left() const { return m_collided_left; }
     float get_width() const { return m_width; }
     float get_height() const { return m_height; }
+    unsigned get_collision_category() const { return m_collision_category; }
+    unsigned get_collision_mask() const { return m_collision_mask; }
 
     void activate()   { m_is_active = true;  };
     void deactivate() { m_is_active = false; };
     // ————— SETTERS ————— //
-    void const set_entity_type(EntityType new_entity_type)  { m_entity_type = new_entity_type;};
+    // Also resets the collision layers to the type's defaults
+    void const set_entity_type(EntityType new_entity_type)
+    {
+        m_entity_type = new_entity_type;
+        m_collision_category = collision_category(new_entity_type);
+        m_collision_mask = collision_mask(new_entity_type);
+    };
+    void const set_collision_category(unsigned new_category) { m_collision_category = new_category; }
+    void const set_collision_mask(unsigned new_mask) { m_collision_mask = new_mask; }
     void const set_ai_type(AIType new_ai_type){ m_ai_type = new_ai_type;};
     void const set_ai_state(AIState new_state){ m_ai_state = new_state;};
     void const set_position(glm::vec3 new_position) { m_position = new_position; }
@@ -141,7 +214,7 @@ public:
         {
             for (int j = 0; j < 4; ++j)
             {
-                m_walking[i][j] = walking[i][j];
+                m_walking[i][j] = (std::int16_t)walking[i][j];
             }
         }
     }
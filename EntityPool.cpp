@@ -0,0 +1,50 @@
+#include "EntityPool.h"
+#include <algorithm>
+
+EntityPool::EntityPool(int capacity)
+{
+    // A handle only has room for MAX_CAPACITY slots
+    capacity = std::min(std::max(capacity, 0), MAX_CAPACITY);
+
+    m_slots.resize(capacity);
+    m_generation.assign(capacity, 1);
+    m_live.assign(capacity, false);
+    clear();
+}
+
+// The slot's handles go stale: its generation moves on, skipping 0 so NULL_ENTITY is never made
+void EntityPool::retire(int slot)
+{
+    m_live[slot] = false;
+    if (++m_generation[slot] == 0) m_generation[slot] = 1;
+}
+
+int EntityPool::take_slot()
+{
+    if (m_free.empty()) return -1;
+
+    int slot = m_free.back();
+    m_free.pop_back();
+    m_live[slot] = true;
+    return slot;
+}
+
+void EntityPool::destroy(EntityHandle handle)
+{
+    if (!get(handle)) return;
+
+    int slot = handle_slot(handle);
+    retire(slot);
+    m_free.push_back(slot);
+}
+
+void EntityPool::clear()
+{
+    // Freed in reverse so slots are handed out from 0 up again
+    m_free.clear();
+    for (int slot = get_capacity() - 1; slot >= 0; slot--)
+    {
+        if (m_live[slot]) retire(slot);
+        m_free.push_back(slot);
+    }
+}
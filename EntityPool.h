@@ -0,0 +1,78 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+// Entities spawned and destroyed while a level runs (the player, enemies, debris),
+// kept in one slab allocated up front. Spawning takes a slot off the free list and
+// destroying puts it back, so neither touches the heap, and a slot's Entity never
+// moves.
+//
+// Entities are referred to by handle rather than Entity*. A handle is the slot's
+// index in the low 16 bits and the slot's generation in the high 16; the generation
+// goes up every time the slot is freed, so a handle to a destroyed entity no longer
+// matches and get() returns null for it, even once the slot is in use again.
+#include "Entity.h"
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+typedef std::uint32_t EntityHandle;
+
+constexpr EntityHandle NULL_ENTITY = 0; // Never handed out: generations start at 1
+
+class EntityPool
+{
+private:
+    std::vector<Entity>        m_slots;      // Sized once, never reallocated
+    std::vector<std::uint16_t> m_generation;
+    std::vector<bool>          m_live;
+    std::vector<int>           m_free;       // Free slots, the next to reuse last
+
+    static int           handle_slot(EntityHandle handle)       { return (int)(handle & 0xFFFFu); }
+    static std::uint16_t handle_generation(EntityHandle handle) { return (std::uint16_t)(handle >> 16); }
+
+    int  take_slot();
+    void retire(int slot);
+    EntityHandle make_handle(int slot) const { return ((EntityHandle)m_generation[slot] << 16) | (EntityHandle)slot; }
+
+public:
+    static constexpr int MAX_CAPACITY = 0x10000;
+
+    // ————— METHODS ————— //
+    explicit EntityPool(int capacity);
+
+    // Constructs an entity in a free slot with any of Entity's constructors. Returns
+    // NULL_ENTITY when the pool is full.
+    template <typename... Args>
+    EntityHandle spawn(Args&&... args)
+    {
+        int slot = take_slot();
+        if (slot < 0) return NULL_ENTITY;
+
+        m_slots[slot].~Entity();
+        new (&m_slots[slot]) Entity(std::forward<Args>(args)...);
+        return make_handle(slot);
+    }
+
+    // Frees the entity's slot; stale and null handles are ignored
+    void destroy(EntityHandle handle);
+    void clear();
+
+    // ————— GETTERS ————— //
+    // The entity, or null if the handle is null or stale
+    Entity* get(EntityHandle handle)
+    {
+        int slot = handle_slot(handle);
+        if (slot >= (int)m_slots.size() || !m_live[slot] || m_generation[slot] != handle_generation(handle)) return nullptr;
+        return &m_slots[slot];
+    }
+    bool is_alive(EntityHandle handle) { return get(handle) != nullptr; }
+
+    // For walking every live entity: the handle in a slot, or NULL_ENTITY if it's free
+    EntityHandle get_handle(int slot) const { return m_live[slot] ? make_handle(slot) : NULL_ENTITY; }
+
+    int get_capacity()   const { return (int)m_slots.size(); }
+    int get_live_count() const { return (int)(m_slots.size() - m_free.size()); }
+};
+
+#endif // ENTITY_POOL_H
@@ -0,0 +1,72 @@
+#include "EntityStore.h"
+#include <cmath>
+
+int EntityStore::add(EntityType type, glm::vec3 position, float width, float height)
+{
+    int id = get_count();
+
+    m_bodies.resize(id + 1);
+    m_bodies.set(id, position, glm::vec3(0.0f), glm::vec3(0.0f));
+    m_width.push_back(width);
+    m_height.push_back(height);
+    m_type.push_back(type);
+    m_collision_category.push_back(collision_category(type));
+    m_collision_mask.push_back(collision_mask(type));
+    return id;
+}
+
+void EntityStore::clear()
+{
+    m_bodies.resize(0);
+    m_width.clear();
+    m_height.clear();
+    m_type.clear();
+    m_collision_category.clear();
+    m_collision_mask.clear();
+}
+
+// ————— SYSTEMS ————— //
+void EntityStore::integrate(IntegratorKind kind, float delta_time)
+{
+    AxisStep step = axis_step(delta_time);
+    m_bodies.integrate(kind, step, step);
+}
+
+void EntityStore::query_box(glm::vec3 position, float width, float height, unsigned category, unsigned mask,
+                            std::vector<int>& hits) const
+{
+    hits.clear();
+    const float* position_x = m_bodies.get_position_x();
+    const float* position_y = m_bodies.get_position_y();
+
+    for (int i = 0; i < get_count(); i++)
+    {
+        if (!layers_collide(category, mask, m_collision_category[i], m_collision_mask[i])) continue;
+
+        float x_distance = std::fabs(position.x - position_x[i]) - ((width + m_width[i]) / 2.0f);
+        float y_distance = std::fabs(position.y - position_y[i]) - ((height + m_height[i]) / 2.0f);
+        if (x_distance < 0.0f && y_distance < 0.0f) hits.push_back(i);
+    }
+}
+
+void EntityStore::pack_colliders(PackedColliders& colliders) const
+{
+    colliders.clear();
+    for (int i = 0; i < get_count(); i++) colliders.add(m_bodies.get_position(i), m_width[i], m_height[i]);
+}
+
+// ————— SETTERS ————— //
+void EntityStore::set_position(int i, glm::vec3 new_position)
+{
+    m_bodies.set(i, new_position, m_bodies.get_velocity(i), m_bodies.get_acceleration(i));
+}
+
+void EntityStore::set_velocity(int i, glm::vec3 new_velocity)
+{
+    m_bodies.set(i, m_bodies.get_position(i), new_velocity, m_bodies.get_acceleration(i));
+}
+
+void EntityStore::set_acceleration(int i, glm::vec3 new_acceleration)
+{
+    m_bodies.set(i, m_bodies.get_position(i), m_bodies.get_velocity(i), new_acceleration);
+}
@@ -0,0 +1,58 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+// The level's entities as structure-of-arrays: one array per component, indexed by
+// entity number, instead of one heap-allocated Entity per box. Only what the
+// systems below touch every tick is kept (motion, extents, type and collision
+// layers), so a scan over the level reads nothing but those, front to back.
+//
+// Entities are numbered in the order they're added and keep their numbers until
+// clear(), so a store filled in the same order as SimState's boxes lines up with them.
+#include "EntityType.h"
+#include "Integrator.h"
+#include "AabbKernel.h"
+#include <vector>
+
+class EntityStore
+{
+private:
+    // ————— COMPONENTS ————— //
+    BodyBatch               m_bodies; // Position, velocity and acceleration
+    std::vector<float>      m_width, m_height;
+    std::vector<EntityType> m_type;
+    std::vector<unsigned>   m_collision_category, m_collision_mask;
+
+public:
+    // ————— METHODS ————— //
+    // Adds an entity at rest on its type's collision layers and returns its number
+    int  add(EntityType type, glm::vec3 position, float width, float height);
+    void clear();
+
+    // ————— SYSTEMS ————— //
+    // Physics: moves every entity one step, in a single pass over the arrays
+    void integrate(IntegratorKind kind, float delta_time);
+
+    // Collision: every entity the box overlaps whose layers collide with the given ones,
+    // in ascending order (hits is cleared first). Same test as Entity::check_collision.
+    void query_box(glm::vec3 position, float width, float height, unsigned category, unsigned mask,
+                   std::vector<int>& hits) const;
+
+    // Collision, many boxes per test: packed copies of every entity, in number order
+    void pack_colliders(PackedColliders& colliders) const;
+
+    // ————— GETTERS ————— //
+    int        get_count()           const { return (int)m_type.size(); }
+    glm::vec3  get_position(int i)   const { return m_bodies.get_position(i); }
+    glm::vec3  get_velocity(int i)   const { return m_bodies.get_velocity(i); }
+    float      get_width(int i)      const { return m_width[i]; }
+    float      get_height(int i)     const { return m_height[i]; }
+    EntityType get_entity_type(int i) const { return m_type[i]; }
+
+    // ————— SETTERS ————— //
+    void set_position(int i, glm::vec3 new_position);
+    void set_velocity(int i, glm::vec3 new_velocity);
+    void set_acceleration(int i, glm::vec3 new_acceleration);
+    void set_collision_mask(int i, unsigned new_mask) { m_collision_mask[i] = new_mask; }
+};
+
+#endif // ENTITY_STORE_H
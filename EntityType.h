@@ -0,0 +1,27 @@
+#ifndef ENTITY_TYPE_H
+#define ENTITY_TYPE_H
+
+// What kind of thing an entity is, and the collision layers each kind is on. Kept
+// apart from Entity.h, which pulls in SDL and OpenGL for rendering, so headless code
+// (EntityStore, the sim library) can use the types without them.
+#include "CollisionLayers.h"
+
+enum EntityType { PLATFORM, PLAYER, ENEMY  };
+
+// ————— COLLISION LAYERS ————— //
+// One layer per EntityType. By default nothing collides with its own type: platforms
+// never move into each other, and enemies walk through one another.
+inline unsigned collision_category(EntityType type) { return 1u << type; }
+
+inline unsigned collision_mask(EntityType type)
+{
+    switch (type)
+    {
+        case PLATFORM: return collision_category(PLAYER) | collision_category(ENEMY);
+        case PLAYER:   return collision_category(PLATFORM) | collision_category(ENEMY);
+        case ENEMY:    return collision_category(PLATFORM) | collision_category(PLAYER);
+        default:       return LAYER_ALL;
+    }
+}
+
+#endif // ENTITY_TYPE_H
@@ -0,0 +1,61 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+// Q16.16 fixed-point numbers: 16 integer bits, 16 fractional bits, in a 32-bit int.
+// Every operation is plain integer arithmetic, so results are the same bits on any
+// compiler, at any optimisation level and on any machine, which floats can't promise
+// (FMA contraction, x87 precision, vectorised reductions).
+//
+// Range is about +-32768 with a step of 1/65536, plenty for a 10 x 7.5 world.
+#include <cstdint>
+
+struct Fixed
+{
+    std::int32_t raw;
+};
+
+constexpr int FIXED_FRACTION_BITS = 16;
+constexpr std::int32_t FIXED_ONE = 1 << FIXED_FRACTION_BITS;
+
+// Right shifts of negative numbers must be arithmetic (guaranteed from C++20, and what
+// every compiler we build with already does)
+static_assert((-3 >> 1) == -2, "Fixed needs arithmetic right shifts");
+
+// Nearest Q16.16 value, halves away from zero. Converting a float is exact up to that
+// rounding, so constants come out the same everywhere.
+constexpr Fixed fixed_from(double value)
+{
+    return Fixed{ (std::int32_t)(value * FIXED_ONE + (value >= 0.0 ? 0.5 : -0.5)) };
+}
+
+constexpr Fixed fixed_from_int(int value) { return Fixed{ value * FIXED_ONE }; }
+inline float fixed_to_float(Fixed value) { return (float)value.raw / (float)FIXED_ONE; }
+
+// ————— ARITHMETIC ————— //
+constexpr Fixed operator+(Fixed a, Fixed b) { return Fixed{ a.raw + b.raw }; }
+constexpr Fixed operator-(Fixed a, Fixed b) { return Fixed{ a.raw - b.raw }; }
+constexpr Fixed operator-(Fixed a)          { return Fixed{ -a.raw }; }
+
+// Products are rounded to nearest, halves up
+constexpr Fixed operator*(Fixed a, Fixed b)
+{
+    return Fixed{ (std::int32_t)(((std::int64_t)a.raw * b.raw + (1 << (FIXED_FRACTION_BITS - 1))) >> FIXED_FRACTION_BITS) };
+}
+
+// Halving is a shift, so it's exact apart from the last bit
+constexpr Fixed fixed_half(Fixed a) { return Fixed{ a.raw >> 1 }; }
+constexpr Fixed fixed_abs(Fixed a)  { return Fixed{ a.raw < 0 ? -a.raw : a.raw }; }
+
+inline Fixed& operator+=(Fixed& a, Fixed b) { a.raw += b.raw; return a; }
+inline Fixed& operator-=(Fixed& a, Fixed b) { a.raw -= b.raw; return a; }
+inline Fixed& operator*=(Fixed& a, Fixed b) { a = a * b; return a; }
+
+// ————— COMPARISONS ————— //
+constexpr bool operator<(Fixed a, Fixed b)  { return a.raw < b.raw; }
+constexpr bool operator>(Fixed a, Fixed b)  { return a.raw > b.raw; }
+constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+
+#endif // FIXED_POINT_H
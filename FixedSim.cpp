@@ -0,0 +1,156 @@
+#include "FixedSim.h"
+#include "LanderHull.h"
+
+// LanderHull.h's templates, run on Q16.16
+struct FixedLanes
+{
+    typedef Fixed F;
+    typedef bool  M;
+
+    static F set(float x)     { return fixed_from(x); }
+    static F add(F a, F b)    { return a + b; }
+    static F sub(F a, F b)    { return a - b; }
+    static F mul(F a, F b)    { return a * b; }
+    static F min(F a, F b)    { return a < b ? a : b; }
+    static F max(F a, F b)    { return a > b ? a : b; }
+    static F abs(F a)         { return fixed_abs(a); }
+    static M lt(F a, F b)     { return a < b; }
+    static M and_(M a, M b)   { return a && b; }
+    static bool any(M m)      { return m; }
+};
+
+constexpr Fixed FIXED_TILT_COS = fixed_from(LANDER_TILT_COS),
+                FIXED_TILT_SIN = fixed_from(LANDER_TILT_SIN),
+                FIXED_HULL_REACH = fixed_from(2.0 * LANDER_HULL_RADIUS); // Side of a box holding the hull at any rotation
+
+void fixed_sim_init(FixedSimState& state, unsigned seed, unsigned episode)
+{
+    for (int i = 0; i < PLATFORM_COUNT; i++) {
+        state.platforms[i].x = fixed_from(platform_x(i));
+        state.platforms[i].y = fixed_from(PLATFORM_Y);
+        state.platforms[i].width = fixed_from(PLATFORM_WIDTH);
+        state.platforms[i].height = fixed_from(PLATFORM_HEIGHT);
+    }
+
+    // The same Philox blocks sim_init draws, mapped to the same ranges with integer math:
+    // x = -4 + u * 8 and y = u * 3 - 1, where u is the top 24 bits over 2^24
+    for (int i = 0; i < ASTEROID_COUNT; i++) {
+        unsigned counter[4] = { (unsigned)i, 0, 0, 0 };
+        unsigned block[4];
+        philox4x32(counter, seed, episode, block);
+
+        state.asteroids[i].x = Fixed{ -4 * FIXED_ONE + (std::int32_t)(block[0] >> 13) };
+        state.asteroids[i].y = Fixed{ (std::int32_t)(((std::uint64_t)(block[1] >> 8) * 3) >> 8) - FIXED_ONE };
+        state.asteroids[i].width = fixed_from(ASTEROID_SIZE);
+        state.asteroids[i].height = fixed_from(ASTEROID_SIZE);
+    }
+
+    fixed_sim_reset(state);
+}
+
+void fixed_sim_reset(FixedSimState& state)
+{
+    state.position_x = fixed_from(LANDER_START_X);
+    state.position_y = fixed_from(LANDER_START_Y);
+    state.velocity_x = state.velocity_y = Fixed{ 0 };
+    state.acceleration_x = Fixed{ 0 };
+    state.acceleration_y = FIXED_GRAVITY;
+    state.fuel = FIXED_MAX_FUEL;
+    state.rotation = Fixed{ 0 };
+
+    state.status = RUNNING;
+    state.game_over = false;
+    state.tick = 0;
+}
+
+bool fixed_check_collision(Fixed x, Fixed y, Fixed width, Fixed height, const FixedBox& other)
+{
+    Fixed x_distance = fixed_abs(x - other.x) - fixed_half(width + other.width);
+    Fixed y_distance = fixed_abs(y - other.y) - fixed_half(height + other.height);
+
+    return x_distance < Fixed{ 0 } && y_distance < Fixed{ 0 };
+}
+
+static void apply_input(FixedSimState& state, unsigned input)
+{
+    const Fixed empty = Fixed{ 0 };
+    state.acceleration_x = empty;
+    state.acceleration_y = FIXED_GRAVITY;
+
+    if (input & INPUT_LEFT) {
+        if (state.fuel > empty) {
+            state.acceleration_x -= FIXED_ACCELERATION_X;
+            state.fuel -= FIXED_FUEL_BURN;
+            state.rotation = FIXED_TILT;
+        }
+    }
+    else if (input & INPUT_RIGHT) {
+        if (state.fuel > empty) {
+            state.acceleration_x += FIXED_ACCELERATION_X;
+            state.fuel -= FIXED_FUEL_BURN;
+            state.rotation = -FIXED_TILT;
+        }
+    }
+    else {
+        state.rotation = empty;
+    }
+
+    if (input & INPUT_THRUST) {
+        if (state.fuel > empty) {
+            state.acceleration_y += FIXED_ACCELERATION_Y;
+            state.fuel -= FIXED_FUEL_BURN;
+        }
+    }
+
+    if (state.fuel < empty) state.fuel = empty;
+}
+
+static bool hull_overlaps_box(const HullFrame<FixedLanes>& hull, const FixedSimState& state, const FixedBox& other)
+{
+    // The hull fits in a square of side FIXED_HULL_REACH whatever its rotation
+    if (!fixed_check_collision(state.position_x, state.position_y, FIXED_HULL_REACH, FIXED_HULL_REACH, other)) return false;
+
+    return hull_overlaps<FixedLanes>(hull, other.x - state.position_x, other.y - state.position_y,
+                                     fixed_half(other.width), fixed_half(other.height));
+}
+
+void fixed_sim_step(FixedSimState& state, unsigned input)
+{
+    if (state.game_over) return;
+
+    apply_input(state, input);
+
+    // The float sim's integrator on Q16.16 lanes; FixedLanes::set rounds the step's
+    // timestep and damping to Q16.16 like every other fixed constant
+    integrate_axis<FixedLanes>(INTEGRATOR_SEMI_IMPLICIT_EULER, LANDER_STEP_X, state.position_x, state.velocity_x, state.acceleration_x);
+    integrate_axis<FixedLanes>(INTEGRATOR_SEMI_IMPLICIT_EULER, LANDER_STEP_Y, state.position_y, state.velocity_y, state.acceleration_y);
+
+    // Only the rules' own tilts ever get here
+    Fixed cos_rotation = state.rotation == Fixed{ 0 } ? fixed_from_int(1) : FIXED_TILT_COS;
+    Fixed sin_rotation = state.rotation == Fixed{ 0 } ? Fixed{ 0 } : state.rotation > Fixed{ 0 } ? FIXED_TILT_SIN : -FIXED_TILT_SIN;
+    HullFrame<FixedLanes> hull = hull_frame<FixedLanes>(cos_rotation, sin_rotation);
+
+    for (int i = 0; i < PLATFORM_COUNT; i++) {
+        if (hull_overlaps_box(hull, state, state.platforms[i])) {
+            bool soft = fixed_abs(state.velocity_y) < fixed_from(LANDING_MAX_SPEED_Y) &&
+                        fixed_abs(state.velocity_x) < fixed_from(LANDING_MAX_SPEED_X);
+            state.status = i == LANDING_ZONE && soft ? MISSION_ACCOMPLISHED : MISSION_FAILED;
+            state.game_over = true;
+        }
+    }
+
+    for (int i = 0; i < ASTEROID_COUNT; i++) {
+        if (hull_overlaps_box(hull, state, state.asteroids[i])) {
+            state.status = MISSION_FAILED;
+            state.game_over = true;
+        }
+    }
+
+    if (state.position_y < fixed_from(WORLD_BOTTOM) || state.position_x < fixed_from(WORLD_LEFT) ||
+        state.position_x > fixed_from(WORLD_RIGHT)) {
+        state.status = MISSION_FAILED;
+        state.game_over = true;
+    }
+
+    state.tick++;
+}
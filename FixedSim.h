@@ -0,0 +1,71 @@
+#ifndef FIXED_SIM_H
+#define FIXED_SIM_H
+
+// The lander simulation again, in Q16.16 fixed point, for when runs have to agree
+// bit for bit between builds and machines: lockstep multiplayer, and replays checked
+// on one machine against traces saved on another. Same rules, same level layout and
+// same inputs as sim_step; the numbers are close to the float simulation's but not
+// equal to them, so the two are never mixed within a run.
+#include "FixedPoint.h"
+#include "Simulation.h"
+
+// Axis-aligned box, centred on (x, y)
+struct FixedBox
+{
+    Fixed x, y;
+    Fixed width, height;
+};
+
+struct FixedSimState
+{
+    // ————— LANDER ————— //
+    Fixed position_x, position_y;
+    Fixed velocity_x, velocity_y;
+    Fixed acceleration_x, acceleration_y;
+    Fixed fuel;
+    Fixed rotation; // Degrees, 0 = pointing up
+
+    // ————— RULES ————— //
+    GameStatus status;
+    bool       game_over;
+    unsigned   tick;
+
+    // ————— LEVEL ————— //
+    FixedBox platforms[PLATFORM_COUNT];
+    FixedBox asteroids[ASTEROID_COUNT];
+};
+
+// ————— CONSTANTS ————— //
+// The float game constants, rounded once
+constexpr Fixed FIXED_GRAVITY         = fixed_from(GRAVITY),
+                FIXED_ACCELERATION_X  = fixed_from(ACCELERATION_X),
+                FIXED_ACCELERATION_Y  = fixed_from(ACCELERATION_Y),
+                FIXED_FUEL_BURN       = fixed_from(FUEL_CONSUMPTION_RATE * FIXED_TIMESTEP), // Per tick
+                FIXED_MAX_FUEL        = fixed_from(MAX_FUEL),
+                FIXED_TILT            = fixed_from(LANDER_TILT);
+
+// Lays out the same level as sim_init(seed, episode), from the same Philox blocks,
+// and puts the lander at the start
+void fixed_sim_init(FixedSimState& state, unsigned seed, unsigned episode = 0);
+
+// Puts the lander back at the start with a full tank, keeping the level layout
+void fixed_sim_reset(FixedSimState& state);
+
+// One FIXED_TIMESTEP: input, integration, hull collisions and win/loss rules, as sim_step
+void fixed_sim_step(FixedSimState& state, unsigned input);
+
+// The box overlap test, as sim_check_collision: touching doesn't count
+bool fixed_check_collision(Fixed x, Fixed y, Fixed width, Fixed height, const FixedBox& other);
+
+// Float copies of the lander, for drawing or comparing with the float simulation
+inline glm::vec3 fixed_sim_position(const FixedSimState& state)
+{
+    return glm::vec3(fixed_to_float(state.position_x), fixed_to_float(state.position_y), 0.0f);
+}
+
+inline glm::vec3 fixed_sim_velocity(const FixedSimState& state)
+{
+    return glm::vec3(fixed_to_float(state.velocity_x), fixed_to_float(state.velocity_y), 0.0f);
+}
+
+#endif // FIXED_SIM_H
@@ -0,0 +1,69 @@
+#include "Integrator.h"
+#include <cmath>
+
+AxisStep axis_step(float timestep, float damping)
+{
+    AxisStep step;
+    step.timestep = timestep;
+    step.damping = damping;
+    step.drag = damping == 1.0f ? 0.0f : -std::log(damping) / timestep;
+    step.verlet_keep = 1.0f / (1.0f + step.drag * timestep * 0.5f);
+    return step;
+}
+
+void BodyBatch::resize(int count)
+{
+    m_position_x.resize(count);
+    m_position_y.resize(count);
+    m_velocity_x.resize(count);
+    m_velocity_y.resize(count);
+    m_acceleration_x.resize(count);
+    m_acceleration_y.resize(count);
+}
+
+void BodyBatch::set(int index, glm::vec3 position, glm::vec3 velocity, glm::vec3 acceleration)
+{
+    m_position_x[index] = position.x;
+    m_position_y[index] = position.y;
+    m_velocity_x[index] = velocity.x;
+    m_velocity_y[index] = velocity.y;
+    m_acceleration_x[index] = acceleration.x;
+    m_acceleration_y[index] = acceleration.y;
+}
+
+namespace
+{
+    // The kind is fixed per instantiation, so each loop is straight-line code the
+    // compiler can vectorise
+    template <IntegratorKind KIND>
+    void integrate_arrays(int count, const AxisStep& step, float* position, float* velocity, const float* acceleration)
+    {
+        for (int i = 0; i < count; i++) {
+            integrate_axis<ScalarLanes>(KIND, step, position[i], velocity[i], acceleration[i]);
+        }
+    }
+
+    void integrate_arrays(IntegratorKind kind, int count, const AxisStep& step, float* position, float* velocity,
+                          const float* acceleration)
+    {
+        switch (kind)
+        {
+            case INTEGRATOR_SEMI_IMPLICIT_EULER:
+                integrate_arrays<INTEGRATOR_SEMI_IMPLICIT_EULER>(count, step, position, velocity, acceleration);
+                break;
+            case INTEGRATOR_VELOCITY_VERLET:
+                integrate_arrays<INTEGRATOR_VELOCITY_VERLET>(count, step, position, velocity, acceleration);
+                break;
+            case INTEGRATOR_RK4:
+                integrate_arrays<INTEGRATOR_RK4>(count, step, position, velocity, acceleration);
+                break;
+        }
+    }
+}
+
+void BodyBatch::integrate(IntegratorKind kind, const AxisStep& x, const AxisStep& y)
+{
+    int count = get_count();
+    integrate_arrays(kind, count, x, m_position_x.data(), m_velocity_x.data(), m_acceleration_x.data());
+    integrate_arrays(kind, count, y, m_position_y.data(), m_velocity_y.data(), m_acceleration_y.data());
+}
@@ -0,0 +1,118 @@
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+// The one integrator everything moves through: the lander in sim_step and
+// LanderBatch, and every Entity in a level. Each axis is integrated on its own as
+//
+//   position' = velocity,  velocity' = acceleration - drag * velocity
+//
+// with the acceleration held for the whole step, which is how the game applies its
+// forces (gravity and thrust are set once per tick).
+//
+// Like LanderHull.h, the kernels are written once against LaneOps.h's lane
+// operations, so a lane of LanderBatch runs the very same float operations as the
+// scalar code. Semi-implicit Euler is the game's own rule and what replays expect;
+// velocity Verlet and RK4 are more accurate at large timesteps for entity passes
+// that don't need to match a recording.
+#include "LaneOps.h"
+#include "glm/glm.hpp"
+#include <vector>
+
+enum IntegratorKind
+{
+    INTEGRATOR_SEMI_IMPLICIT_EULER, // v += a dt, v *= damping, x += v dt
+    INTEGRATOR_VELOCITY_VERLET,     // Trapezoidal velocity, solved exactly for the drag term
+    INTEGRATOR_RK4                  // Classic fourth-order Runge-Kutta
+};
+
+// One axis' constants for a step, worked out once per pass rather than per body
+struct AxisStep
+{
+    float timestep;
+    float damping;     // Share of its velocity a coasting body keeps over one step (1 = none lost)
+    float drag;        // The same damping as a continuous rate, -ln(damping) / timestep
+    float verlet_keep; // 1 / (1 + drag * timestep / 2)
+};
+
+AxisStep axis_step(float timestep, float damping = 1.0f);
+
+// The same, for a step fixed at compile time. There's no constexpr log, so the caller
+// gives drag, worked out as axis_step would (0 when damping is 1).
+constexpr AxisStep axis_step_with_drag(float timestep, float damping, float drag)
+{
+    return AxisStep{ timestep, damping, drag, 1.0f / (1.0f + drag * timestep * 0.5f) };
+}
+
+// Advances one axis of one body (or one register of bodies) by step.timestep
+template <typename L>
+void integrate_axis(IntegratorKind kind, const AxisStep& step, typename L::F& position, typename L::F& velocity,
+                    typename L::F acceleration)
+{
+    typedef typename L::F F;
+    F timestep = L::set(step.timestep);
+
+    if (kind == INTEGRATOR_SEMI_IMPLICIT_EULER)
+    {
+        velocity = L::add(velocity, L::mul(acceleration, timestep));
+        if (step.damping != 1.0f) velocity = L::mul(velocity, L::set(step.damping));
+        position = L::add(position, L::mul(velocity, timestep));
+    }
+    else if (kind == INTEGRATOR_VELOCITY_VERLET)
+    {
+        // x += v dt + a0 dt^2 / 2, then v1 = v + (a0 + a1) dt / 2 with a1 = a - drag v1
+        F half_step = L::set(step.timestep * 0.5f);
+        F drag = L::set(step.drag);
+        F start_acceleration = L::sub(acceleration, L::mul(drag, velocity));
+
+        position = L::add(position, L::mul(timestep, L::add(velocity, L::mul(half_step, start_acceleration))));
+        velocity = L::mul(L::add(velocity, L::mul(half_step, L::add(start_acceleration, acceleration))),
+                          L::set(step.verlet_keep));
+    }
+    else
+    {
+        F half_step = L::set(step.timestep * 0.5f);
+        F sixth_step = L::set(step.timestep / 6.0f);
+        F two = L::set(2.0f);
+        F drag = L::set(step.drag);
+
+        F velocity_1 = velocity;
+        F slope_1 = L::sub(acceleration, L::mul(drag, velocity_1));
+        F velocity_2 = L::add(velocity, L::mul(half_step, slope_1));
+        F slope_2 = L::sub(acceleration, L::mul(drag, velocity_2));
+        F velocity_3 = L::add(velocity, L::mul(half_step, slope_2));
+        F slope_3 = L::sub(acceleration, L::mul(drag, velocity_3));
+        F velocity_4 = L::add(velocity, L::mul(timestep, slope_3));
+        F slope_4 = L::sub(acceleration, L::mul(drag, velocity_4));
+
+        position = L::add(position, L::mul(sixth_step, L::add(L::add(velocity_1, L::mul(two, L::add(velocity_2, velocity_3))), velocity_4)));
+        velocity = L::add(velocity, L::mul(sixth_step, L::add(L::add(slope_1, L::mul(two, L::add(slope_2, slope_3))), slope_4)));
+    }
+}
+
+// Bodies as structure-of-arrays, integrated in one pass. It's either scratch space that
+// callers copy their bodies into and back out of (Entity::update_all), or where the
+// bodies live for good (EntityStore).
+class BodyBatch
+{
+private:
+    std::vector<float> m_position_x, m_position_y;
+    std::vector<float> m_velocity_x, m_velocity_y;
+    std::vector<float> m_acceleration_x, m_acceleration_y;
+
+public:
+    // ————— METHODS ————— //
+    void resize(int count);
+
+    void set(int index, glm::vec3 position, glm::vec3 velocity, glm::vec3 acceleration);
+    void integrate(IntegratorKind kind, const AxisStep& x, const AxisStep& y);
+
+    // ————— GETTERS ————— //
+    int get_count() const { return (int)m_position_x.size(); }
+    glm::vec3 get_position(int index) const { return glm::vec3(m_position_x[index], m_position_y[index], 0.0f); }
+    glm::vec3 get_velocity(int index) const { return glm::vec3(m_velocity_x[index], m_velocity_y[index], 0.0f); }
+    glm::vec3 get_acceleration(int index) const { return glm::vec3(m_acceleration_x[index], m_acceleration_y[index], 0.0f); }
+    const float* get_position_x() const { return m_position_x.data(); }
+    const float* get_position_y() const { return m_position_y.data(); }
+};
+
+#endif // INTEGRATOR_H
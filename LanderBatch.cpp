@@ -0,0 +1,364 @@
+#include "LanderBatch.h"
+#include "LanderHull.h"
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define LANDER_BATCH_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LANDER_BATCH_SSE2
+#endif
+
+// ————— LANE OPERATIONS ————— //
+// Each wrapper exposes the same handful of operations so the tick kernel below is
+// written once, and so LanderHull.h's templates can run on it. Masks are kept in the
+// float register type, all bits set per true lane.
+#if defined(LANDER_BATCH_AVX2)
+struct Lanes
+{
+    typedef __m256  F;
+    typedef __m256i I;
+    typedef __m256  M;
+    static constexpr int WIDTH = 8;
+
+    static F load(const float* p)       { return _mm256_loadu_ps(p); }
+    static void store(float* p, F v)    { _mm256_storeu_ps(p, v); }
+    static I load_i(const void* p)      { return _mm256_loadu_si256((const __m256i*)p); }
+    static void store_i(void* p, I v)   { _mm256_storeu_si256((__m256i*)p, v); }
+    static I load_input(const unsigned char* p) { return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)p)); }
+
+    static F set(float x)               { return _mm256_set1_ps(x); }
+    static I set_i(int x)               { return _mm256_set1_epi32(x); }
+
+    static F add(F a, F b)              { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b)              { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b)              { return _mm256_mul_ps(a, b); }
+    static I add_i(I a, I b)            { return _mm256_add_epi32(a, b); }
+    static F abs(F a)                   { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static F min(F a, F b)              { return _mm256_min_ps(a, b); } // a < b ? a : b, as ScalarLanes
+    static F max(F a, F b)              { return _mm256_max_ps(a, b); } // a > b ? a : b
+
+    static F lt(F a, F b)               { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static F gt(F a, F b)               { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static F eq(F a, F b)               { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static F eq_i(I a, I b)             { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+    static F has_bits(I a, int bits)    { I b = _mm256_set1_epi32(bits); return eq_i(_mm256_and_si256(a, b), b); }
+
+    static F and_(F a, F b)             { return _mm256_and_ps(a, b); }
+    static F or_(F a, F b)              { return _mm256_or_ps(a, b); }
+    static F andnot(F a, F b)           { return _mm256_andnot_ps(a, b); } // ~a & b
+    static F select(F m, F a, F b)      { return _mm256_blendv_ps(b, a, m); }
+    static I select_i(F m, I a, I b)    { return _mm256_castps_si256(select(m, _mm256_castsi256_ps(a), _mm256_castsi256_ps(b))); }
+    static I mask_i(F m)                { return _mm256_castps_si256(m); }
+    static I and_i(I a, I b)            { return _mm256_and_si256(a, b); }
+    static bool any(F m)                { return _mm256_movemask_ps(m) != 0; }
+};
+#elif defined(LANDER_BATCH_SSE2)
+struct Lanes
+{
+    typedef __m128  F;
+    typedef __m128i I;
+    typedef __m128  M;
+    static constexpr int WIDTH = 4;
+
+    static F load(const float* p)       { return _mm_loadu_ps(p); }
+    static void store(float* p, F v)    { _mm_storeu_ps(p, v); }
+    static I load_i(const void* p)      { return _mm_loadu_si128((const __m128i*)p); }
+    static void store_i(void* p, I v)   { _mm_storeu_si128((__m128i*)p, v); }
+    static I load_input(const unsigned char* p)
+    {
+        int bytes;
+        std::memcpy(&bytes, p, sizeof(bytes));
+        I zero = _mm_setzero_si128();
+        return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+    }
+
+    static F set(float x)               { return _mm_set1_ps(x); }
+    static I set_i(int x)               { return _mm_set1_epi32(x); }
+
+    static F add(F a, F b)              { return _mm_add_ps(a, b); }
+    static F sub(F a, F b)              { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b)              { return _mm_mul_ps(a, b); }
+    static I add_i(I a, I b)            { return _mm_add_epi32(a, b); }
+    static F abs(F a)                   { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static F min(F a, F b)              { return _mm_min_ps(a, b); } // a < b ? a : b, as ScalarLanes
+    static F max(F a, F b)              { return _mm_max_ps(a, b); } // a > b ? a : b
+
+    static F lt(F a, F b)               { return _mm_cmplt_ps(a, b); }
+    static F gt(F a, F b)               { return _mm_cmpgt_ps(a, b); }
+    static F eq(F a, F b)               { return _mm_cmpeq_ps(a, b); }
+    static F eq_i(I a, I b)             { return _mm_castsi128_ps(_mm_cmpeq_epi32(a, b)); }
+    static F has_bits(I a, int bits)    { I b = _mm_set1_epi32(bits); return eq_i(_mm_and_si128(a, b), b); }
+
+    static F and_(F a, F b)             { return _mm_and_ps(a, b); }
+    static F or_(F a, F b)              { return _mm_or_ps(a, b); }
+    static F andnot(F a, F b)           { return _mm_andnot_ps(a, b); } // ~a & b
+    static F select(F m, F a, F b)      { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static I select_i(F m, I a, I b)    { return _mm_castps_si128(select(m, _mm_castsi128_ps(a), _mm_castsi128_ps(b))); }
+    static I mask_i(F m)                { return _mm_castps_si128(m); }
+    static I and_i(I a, I b)            { return _mm_and_si128(a, b); }
+    static bool any(F m)                { return _mm_movemask_ps(m) != 0; }
+};
+#endif
+
+LanderBatch::LanderBatch(int size)
+    : m_size(size),
+    m_capacity((size + LANE_ALIGNMENT - 1) / LANE_ALIGNMENT * LANE_ALIGNMENT),
+    m_position_x(m_capacity, 0.0f), m_position_y(m_capacity, 0.0f),
+    m_velocity_x(m_capacity, 0.0f), m_velocity_y(m_capacity, 0.0f),
+    m_acceleration_x(m_capacity, 0.0f), m_acceleration_y(m_capacity, 0.0f),
+    m_fuel(m_capacity, 0.0f), m_rotation(m_capacity, 0.0f),
+    m_status(m_capacity, MISSION_FAILED), m_tick(m_capacity, 0),
+    m_rng_key0(m_capacity, 0), m_rng_key1(m_capacity, 0), m_rng_counter(m_capacity, 0),
+    m_asteroid_x(ASTEROID_COUNT * m_capacity, 0.0f), m_asteroid_y(ASTEROID_COUNT * m_capacity, 0.0f),
+    m_input(m_capacity, INPUT_NONE)
+{
+    sim_place_platforms(m_platforms);
+}
+
+void LanderBatch::init(unsigned seed, unsigned first_episode)
+{
+    for (int i = 0; i < m_size; i++) {
+        m_rng_key0[i] = seed;
+        m_rng_key1[i] = first_episode + (unsigned)i;
+        m_rng_counter[i] = ASTEROID_COUNT;
+    }
+
+    // Asteroid a of every lander comes from Philox block a of that lander's stream
+    std::vector<unsigned> bits_x(m_size), bits_y(m_size), unused_z(m_size), unused_w(m_size);
+    unsigned* words[4] = { bits_x.data(), bits_y.data(), unused_z.data(), unused_w.data() };
+
+    for (int a = 0; a < ASTEROID_COUNT; a++) {
+        unsigned counter[4] = { (unsigned)a, 0, 0, 0 };
+        philox4x32_lanes(m_size, counter, seed, m_rng_key1.data(), words);
+
+        float* asteroid_x = &m_asteroid_x[a * m_capacity];
+        float* asteroid_y = &m_asteroid_y[a * m_capacity];
+        for (int i = 0; i < m_size; i++) {
+            asteroid_x[i] = asteroid_x_from(bits_x[i]);
+            asteroid_y[i] = asteroid_y_from(bits_y[i]);
+        }
+    }
+
+    reset_all();
+}
+
+void LanderBatch::reset(int index)
+{
+    SimState state;
+    store(index, state);
+    sim_reset(state);
+    load(index, state);
+}
+
+void LanderBatch::reset_all()
+{
+    for (int i = 0; i < m_size; i++) reset(i);
+}
+
+void LanderBatch::next_episode(int index)
+{
+    SimState state;
+    sim_init(state, m_rng_key0[index], m_rng_key1[index] + (unsigned)m_size);
+    load(index, state);
+}
+
+void LanderBatch::load(int index, const SimState& state)
+{
+    m_position_x[index] = state.position.x;
+    m_position_y[index] = state.position.y;
+    m_velocity_x[index] = state.velocity.x;
+    m_velocity_y[index] = state.velocity.y;
+    m_acceleration_x[index] = state.acceleration.x;
+    m_acceleration_y[index] = state.acceleration.y;
+    m_fuel[index] = state.fuel;
+    m_rotation[index] = state.rotation;
+    m_status[index] = state.game_over ? state.status : RUNNING;
+    m_tick[index] = state.tick;
+    m_rng_key0[index] = state.rng_key[0];
+    m_rng_key1[index] = state.rng_key[1];
+    m_rng_counter[index] = state.rng_counter;
+
+    for (int i = 0; i < ASTEROID_COUNT; i++) {
+        m_asteroid_x[i * m_capacity + index] = state.asteroids[i].position.x;
+        m_asteroid_y[i * m_capacity + index] = state.asteroids[i].position.y;
+    }
+}
+
+void LanderBatch::store(int index, SimState& state) const
+{
+    state.position = glm::vec3(m_position_x[index], m_position_y[index], 0.0f);
+    state.velocity = glm::vec3(m_velocity_x[index], m_velocity_y[index], 0.0f);
+    state.acceleration = glm::vec3(m_acceleration_x[index], m_acceleration_y[index], 0.0f);
+    state.fuel = m_fuel[index];
+    state.rotation = m_rotation[index];
+    state.status = (GameStatus)m_status[index];
+    state.game_over = m_status[index] != RUNNING;
+    state.tick = m_tick[index];
+    state.time_accumulator = 0.0f;
+    state.rng_key[0] = m_rng_key0[index];
+    state.rng_key[1] = m_rng_key1[index];
+    state.rng_counter = m_rng_counter[index];
+
+    for (int i = 0; i < PLATFORM_COUNT; i++) state.platforms[i] = m_platforms[i];
+    for (int i = 0; i < ASTEROID_COUNT; i++) {
+        state.asteroids[i].position = glm::vec3(m_asteroid_x[i * m_capacity + index], m_asteroid_y[i * m_capacity + index], 0.0f);
+        state.asteroids[i].width = ASTEROID_SIZE;
+        state.asteroids[i].height = ASTEROID_SIZE;
+    }
+}
+
+// Fallback for targets without SSE2: round-trip every lander through sim_step
+void LanderBatch::step_scalar()
+{
+    SimState state;
+    for (int i = 0; i < m_size; i++) {
+        if (m_status[i] != RUNNING) continue;
+        store(i, state);
+        sim_step(state, m_input[i]);
+        load(i, state);
+    }
+}
+
+void LanderBatch::step(const unsigned char* inputs)
+{
+    std::memcpy(m_input.data(), inputs, m_size);
+
+#if defined(LANDER_BATCH_AVX2) || defined(LANDER_BATCH_SSE2)
+    typedef Lanes L;
+    typedef L::F F;
+    typedef L::I I;
+
+    // Same expressions as sim_apply_input / sim_step, evaluated in the same order
+    const F zero        = L::set(0.0f);
+    const F burn        = L::set(FUEL_CONSUMPTION_RATE * FIXED_TIMESTEP);
+    const F gravity     = L::set(GRAVITY);
+    const F thrust_y    = L::add(gravity, L::set(ACCELERATION_Y));
+    const F left_x      = L::sub(zero, L::set(ACCELERATION_X));
+    const F right_x     = L::add(zero, L::set(ACCELERATION_X));
+    const F max_speed_x = L::set(LANDING_MAX_SPEED_X);
+    const F max_speed_y = L::set(LANDING_MAX_SPEED_Y);
+    const F asteroid_half = L::set(ASTEROID_SIZE / 2.0f);
+    const F asteroid_near = L::set(LANDER_HULL_RADIUS + ASTEROID_SIZE / 2.0f);
+    const F tilt        = L::set(LANDER_TILT);
+    const I running     = L::set_i(RUNNING);
+    const I failed      = L::set_i(MISSION_FAILED);
+    const I accomplished = L::set_i(MISSION_ACCOMPLISHED);
+
+    for (int i = 0; i < m_capacity; i += L::WIDTH)
+    {
+        I status = L::load_i(&m_status[i]);
+        F live = L::eq_i(status, running);
+        if (!L::any(live)) continue;
+
+        // ————— INPUT ————— //
+        I input  = L::load_input(&m_input[i]);
+        F left   = L::has_bits(input, INPUT_LEFT);
+        F right  = L::andnot(left, L::has_bits(input, INPUT_RIGHT));
+        F thrust = L::has_bits(input, INPUT_THRUST);
+
+        F fuel     = L::load(&m_fuel[i]);
+        F rotation = L::load(&m_rotation[i]);
+
+        F sideways    = L::or_(left, right);
+        F side_burn   = L::and_(sideways, L::gt(fuel, zero));
+        F acceleration_x = L::select(L::and_(left, side_burn), left_x,
+                           L::select(L::and_(right, side_burn), right_x, zero));
+        F new_rotation = L::select(L::and_(left, side_burn), tilt,
+                         L::select(L::and_(right, side_burn), L::set(-LANDER_TILT),
+                         L::select(sideways, rotation, zero)));
+        fuel = L::select(side_burn, L::sub(fuel, burn), fuel);
+
+        F up_burn = L::and_(thrust, L::gt(fuel, zero));
+        F acceleration_y = L::select(up_burn, thrust_y, gravity);
+        fuel = L::select(up_burn, L::sub(fuel, burn), fuel);
+        fuel = L::select(L::lt(fuel, zero), zero, fuel);
+
+        // ————— INTEGRATION ————— //
+        F position_x = L::load(&m_position_x[i]), velocity_x = L::load(&m_velocity_x[i]);
+        F position_y = L::load(&m_position_y[i]), velocity_y = L::load(&m_velocity_y[i]);
+        integrate_axis<L>(INTEGRATOR_SEMI_IMPLICIT_EULER, LANDER_STEP_X, position_x, velocity_x, acceleration_x);
+        integrate_axis<L>(INTEGRATOR_SEMI_IMPLICIT_EULER, LANDER_STEP_Y, position_y, velocity_y, acceleration_y);
+
+        // ————— RULES ————— //
+        I outcome = status;
+        F soft = L::and_(L::lt(L::abs(velocity_y), max_speed_y), L::lt(L::abs(velocity_x), max_speed_x));
+
+        F crashed = L::gt(zero, zero);
+
+        // ————— HULL ————— //
+        // Blocks nowhere near a box skip the hull entirely; that's nearly every tick of a run
+        F near = L::gt(zero, zero);
+        for (int p = 0; p < PLATFORM_COUNT; p++)
+        {
+            const SimBox& platform = m_platforms[p];
+            near = L::or_(near, L::and_(L::lt(L::abs(L::sub(position_x, L::set(platform.position.x))), L::set(LANDER_HULL_RADIUS + platform.width / 2.0f)),
+                                        L::lt(L::abs(L::sub(position_y, L::set(platform.position.y))), L::set(LANDER_HULL_RADIUS + platform.height / 2.0f))));
+        }
+        for (int a = 0; a < ASTEROID_COUNT; a++)
+        {
+            near = L::or_(near, L::and_(L::lt(L::abs(L::sub(position_x, L::load(&m_asteroid_x[a * m_capacity + i]))), asteroid_near),
+                                        L::lt(L::abs(L::sub(position_y, L::load(&m_asteroid_y[a * m_capacity + i]))), asteroid_near)));
+        }
+
+        if (L::any(L::and_(near, live)))
+        {
+            // The rules only ever tilt by 0 or LANDER_TILT either way; anything else (a state
+            // loaded from elsewhere) gets its cos and sin from sim_hull_rotation lane by lane
+            F upright = L::eq(new_rotation, zero);
+            F leans_left = L::eq(new_rotation, tilt);
+            F leans_right = L::eq(new_rotation, L::set(-LANDER_TILT));
+            F cos_rotation = L::select(upright, L::set(1.0f), L::set(LANDER_TILT_COS));
+            F sin_rotation = L::select(leans_left, L::set(LANDER_TILT_SIN), L::select(leans_right, L::set(-LANDER_TILT_SIN), zero));
+
+            if (L::any(L::andnot(L::or_(upright, L::or_(leans_left, leans_right)), live)))
+            {
+                alignas(32) float rotations[L::WIDTH], cosines[L::WIDTH], sines[L::WIDTH];
+                L::store(rotations, new_rotation);
+                for (int lane = 0; lane < L::WIDTH; lane++) sim_hull_rotation(rotations[lane], cosines[lane], sines[lane]);
+                cos_rotation = L::load(cosines);
+                sin_rotation = L::load(sines);
+            }
+
+            HullFrame<L> hull = hull_frame<L>(cos_rotation, sin_rotation);
+
+            for (int p = 0; p < PLATFORM_COUNT; p++)
+            {
+                const SimBox& platform = m_platforms[p];
+                F hit = hull_overlaps<L>(hull, L::sub(L::set(platform.position.x), position_x), L::sub(L::set(platform.position.y), position_y),
+                                         L::set(platform.width / 2.0f), L::set(platform.height / 2.0f));
+
+                I result = p == LANDING_ZONE ? L::select_i(soft, accomplished, failed) : failed;
+                outcome = L::select_i(hit, result, outcome);
+            }
+
+            for (int a = 0; a < ASTEROID_COUNT; a++)
+            {
+                F hit = hull_overlaps<L>(hull, L::sub(L::load(&m_asteroid_x[a * m_capacity + i]), position_x),
+                                         L::sub(L::load(&m_asteroid_y[a * m_capacity + i]), position_y), asteroid_half, asteroid_half);
+                crashed = L::or_(crashed, hit);
+            }
+        }
+
+        crashed = L::or_(crashed, L::lt(position_y, L::set(WORLD_BOTTOM)));
+        crashed = L::or_(crashed, L::lt(position_x, L::set(WORLD_LEFT)));
+        crashed = L::or_(crashed, L::gt(position_x, L::set(WORLD_RIGHT)));
+        outcome = L::select_i(crashed, failed, outcome);
+
+        // Landers that were already finished keep everything as it was
+        L::store(&m_position_x[i], L::select(live, position_x, L::load(&m_position_x[i])));
+        L::store(&m_position_y[i], L::select(live, position_y, L::load(&m_position_y[i])));
+        L::store(&m_velocity_x[i], L::select(live, velocity_x, L::load(&m_velocity_x[i])));
+        L::store(&m_velocity_y[i], L::select(live, velocity_y, L::load(&m_velocity_y[i])));
+        L::store(&m_acceleration_x[i], L::select(live, acceleration_x, L::load(&m_acceleration_x[i])));
+        L::store(&m_acceleration_y[i], L::select(live, acceleration_y, L::load(&m_acceleration_y[i])));
+        L::store(&m_fuel[i], L::select(live, fuel, L::load(&m_fuel[i])));
+        L::store(&m_rotation[i], L::select(live, new_rotation, rotation));
+        L::store_i(&m_status[i], L::select_i(live, outcome, status));
+        L::store_i(&m_tick[i], L::add_i(L::load_i(&m_tick[i]), L::and_i(L::mask_i(live), L::set_i(1))));
+    }
+#else
+    step_scalar();
+#endif
+}
@@ -0,0 +1,83 @@
+#ifndef LANDER_BATCH_H
+#define LANDER_BATCH_H
+
+// Many independent landers stepped together. State is kept as structure-of-arrays
+// so one tick of sim_step runs across 8 (AVX2, /arch:AVX2 or -mavx2) or 4 (SSE2)
+// landers at a time, with exactly the same float operations as Simulation.cpp.
+//
+// The kernel is picked when LanderSim is compiled. Its x64 configurations build
+// with /arch:AVX2, so x64 ships the 8-wide kernels (and needs an AVX2 CPU); Win32
+// ships SSE2. Random.cpp and AabbKernel.cpp choose theirs the same way.
+#include "Simulation.h"
+#include <vector>
+
+class LanderBatch
+{
+private:
+    int m_size;
+    int m_capacity; // m_size rounded up to the widest SIMD width; padding lanes are never RUNNING
+
+    // ————— LANDERS ————— //
+    std::vector<float>    m_position_x, m_position_y;
+    std::vector<float>    m_velocity_x, m_velocity_y;
+    std::vector<float>    m_acceleration_x, m_acceleration_y;
+    std::vector<float>    m_fuel;
+    std::vector<float>    m_rotation;
+    std::vector<int>      m_status; // GameStatus per lander
+    std::vector<unsigned> m_tick;
+    std::vector<unsigned> m_rng_key0, m_rng_key1, m_rng_counter;
+
+    // ————— LEVEL ————— //
+    // Every lander shares the platform layout; asteroids are placed per lander,
+    // stored asteroid-major (all landers' asteroid 0, then asteroid 1, ...)
+    SimBox m_platforms[PLATFORM_COUNT];
+    std::vector<float> m_asteroid_x, m_asteroid_y;
+
+    std::vector<unsigned char> m_input; // Padded copy of the caller's inputs
+
+    void step_scalar();
+
+public:
+    static constexpr int LANE_ALIGNMENT = 8;
+
+    // ————— METHODS ————— //
+    explicit LanderBatch(int size);
+
+    // Lays out a level for every lander and puts them all at the start. Lander i
+    // gets the same level as sim_init(state, seed, first_episode + i), with the
+    // Philox draws for the whole batch done together.
+    void init(unsigned seed, unsigned first_episode = 0);
+
+    // Put landers back at the start of the level they're on
+    void reset(int index);
+    void reset_all();
+
+    // Moves lander index on to a new level: its episode id goes up by the batch size,
+    // so landers never share a level, and its asteroids are placed as sim_init places
+    // them for the new id. It starts there at the start.
+    void next_episode(int index);
+
+    // Advances every lander one FIXED_TIMESTEP; inputs holds one LanderInput mask per lander
+    void step(const unsigned char* inputs);
+
+    // Copies one lander in or out of the batch. The platform layout is shared, so
+    // load() only takes the lander and its asteroids from the given state.
+    void load(int index, const SimState& state);
+    void store(int index, SimState& state) const;
+
+    // ————— GETTERS ————— //
+    int get_size() const { return m_size; }
+    int get_capacity() const { return m_capacity; }
+
+    const float* get_position_x() const { return m_position_x.data(); }
+    const float* get_position_y() const { return m_position_y.data(); }
+    const float* get_velocity_x() const { return m_velocity_x.data(); }
+    const float* get_velocity_y() const { return m_velocity_y.data(); }
+    const float* get_fuel()       const { return m_fuel.data(); }
+    const float* get_rotation()   const { return m_rotation.data(); }
+    const int*   get_status()     const { return m_status.data(); }
+    const unsigned* get_tick()    const { return m_tick.data(); }
+    const SimBox* get_platforms() const { return m_platforms; }
+};
+
+#endif // LANDER_BATCH_H
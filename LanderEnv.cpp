@@ -0,0 +1,82 @@
+#include "LanderEnv.h"
+#include "LanderBatch.h"
+
+struct LanderEnv
+{
+    LanderBatch batch;
+
+    explicit LanderEnv(int env_count) : batch(env_count) {}
+};
+
+static void write_observations(const LanderBatch& batch, float* observations)
+{
+    const float* position_x = batch.get_position_x();
+    const float* position_y = batch.get_position_y();
+    const float* velocity_x = batch.get_velocity_x();
+    const float* velocity_y = batch.get_velocity_y();
+    const float* fuel       = batch.get_fuel();
+    const float* rotation   = batch.get_rotation();
+
+    for (int i = 0; i < batch.get_size(); i++) {
+        float* row = observations + i * LANDER_ENV_OBSERVATION_SIZE;
+        row[0] = position_x[i];
+        row[1] = position_y[i];
+        row[2] = velocity_x[i];
+        row[3] = velocity_y[i];
+        row[4] = fuel[i];
+        row[5] = rotation[i];
+    }
+}
+
+LanderEnv* lander_env_create(int env_count, unsigned seed)
+{
+    if (env_count < 1) return nullptr;
+
+    LanderEnv* env = new LanderEnv(env_count);
+    env->batch.init(seed);
+    return env;
+}
+
+void lander_env_destroy(LanderEnv* env)
+{
+    delete env;
+}
+
+int lander_env_count(const LanderEnv* env)
+{
+    return env->batch.get_size();
+}
+
+void lander_env_reset(LanderEnv* env, float* observations)
+{
+    env->batch.reset_all();
+    write_observations(env->batch, observations);
+}
+
+void lander_env_step(LanderEnv* env, const unsigned char* actions,
+                     float* observations, float* rewards, unsigned char* dones)
+{
+    LanderBatch& batch = env->batch;
+    batch.step(actions);
+
+    // Every env was running going into the step, so anything finished now ended on it
+    const int* status = batch.get_status();
+    for (int i = 0; i < batch.get_size(); i++) {
+        if (status[i] == RUNNING) {
+            rewards[i] = 0.0f;
+            dones[i] = 0;
+            continue;
+        }
+
+        rewards[i] = status[i] == MISSION_ACCOMPLISHED ? LANDER_ENV_REWARD_LANDED : LANDER_ENV_REWARD_CRASHED;
+        dones[i] = 1;
+        batch.next_episode(i);
+    }
+
+    write_observations(batch, observations);
+}
+
+void lander_env_observe(const LanderEnv* env, float* observations)
+{
+    write_observations(env->batch, observations);
+}
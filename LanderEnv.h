@@ -0,0 +1,62 @@
+#ifndef LANDER_ENV_H
+#define LANDER_ENV_H
+
+/*
+ * C interface to a batch of lander environments for external trainers.
+ * Every call covers the whole batch and writes straight into caller-owned,
+ * contiguous buffers; nothing is allocated or copied per lander.
+ *
+ * Buffer layouts (env_count = lander_env_count(env)):
+ *   actions       unsigned char[env_count]                          LanderInput bitmask per env
+ *   observations  float[env_count * LANDER_ENV_OBSERVATION_SIZE]    one row per env, see below
+ *   rewards       float[env_count]
+ *   dones         unsigned char[env_count]                          1 when the episode ended this step
+ *
+ * An env whose episode ends is reset straight away, so the observation
+ * written for it on that step is already the first one of its next episode.
+ * That episode is on a new level: env i plays episode ids i, i + env_count,
+ * i + 2 * env_count, ... of the seed in turn, each laid out as sim_init lays
+ * out that id, so no two envs ever play the same level.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32) && defined(LANDER_ENV_EXPORTS)
+    #define LANDER_ENV_API __declspec(dllexport)
+#elif defined(_WIN32) && defined(LANDER_ENV_IMPORTS)
+    #define LANDER_ENV_API __declspec(dllimport)
+#else
+    #define LANDER_ENV_API
+#endif
+
+/* Observation row: position x, position y, velocity x, velocity y, fuel, rotation (degrees) */
+#define LANDER_ENV_OBSERVATION_SIZE 6
+
+/* Rewards handed out on the step an episode ends; every other step pays 0 */
+#define LANDER_ENV_REWARD_LANDED   1.0f
+#define LANDER_ENV_REWARD_CRASHED -1.0f
+
+typedef struct LanderEnv LanderEnv;
+
+/* Env i's first level is laid out from seed and episode id i. Returns NULL if env_count < 1. */
+LANDER_ENV_API LanderEnv* lander_env_create(int env_count, unsigned seed);
+LANDER_ENV_API void       lander_env_destroy(LanderEnv* env);
+LANDER_ENV_API int        lander_env_count(const LanderEnv* env);
+
+/* Restarts every env at the start of the level it's on and writes its first observation */
+LANDER_ENV_API void lander_env_reset(LanderEnv* env, float* observations);
+
+/* Advances every env one fixed timestep with the given controls */
+LANDER_ENV_API void lander_env_step(LanderEnv* env, const unsigned char* actions,
+                                    float* observations, float* rewards, unsigned char* dones);
+
+/* Writes the current observations without stepping */
+LANDER_ENV_API void lander_env_observe(const LanderEnv* env, float* observations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LANDER_ENV_H */
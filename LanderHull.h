@@ -0,0 +1,128 @@
+#ifndef LANDER_HULL_H
+#define LANDER_HULL_H
+
+// Exact overlap test between the lander's triangular hull, rotated as it's drawn,
+// and an axis-aligned box, by the separating axis theorem. The candidate axes are
+// x, y and the normal of each hull edge; the shapes overlap when their shadows
+// overlap on all five, and only touching on one of them doesn't count.
+//
+// The test is written once against LaneOps.h's lane operations, so sim_step (one
+// lander, plain floats) and LanderBatch (8 or 4 landers per register) run the same
+// float operations in the same order and always agree bit for bit.
+#include "LaneOps.h"
+#include <cmath>
+
+// The triangle draw_lander draws, centred on the lander's position
+constexpr float LANDER_HULL_X[3] = { 0.0f, -0.5f, 0.5f },
+                LANDER_HULL_Y[3] = { 0.5f, -0.5f, -0.5f };
+
+// Every vertex lies within this of the centre whatever the rotation (sqrt(0.5), rounded
+// well up), so a box farther than this plus its half-size on x or y can't be touching
+constexpr float LANDER_HULL_RADIUS = 0.708f;
+
+// Everything about the hull that depends only on its rotation, worked out once per
+// tick and then reused against every box
+template <typename L>
+struct HullFrame
+{
+    typename L::F min_x, max_x, min_y, max_y;  // Bounding box, relative to the lander
+    typename L::F edge_x[3], edge_y[3];        // Edge k runs from vertex k to vertex k + 1
+    typename L::F abs_edge_x[3], abs_edge_y[3];
+    typename L::F shadow_min[3], shadow_max[3]; // Hull's extent along each edge normal
+};
+
+template <typename L>
+HullFrame<L> hull_frame(typename L::F cos_rotation, typename L::F sin_rotation)
+{
+    typedef typename L::F F;
+    HullFrame<L> frame;
+
+    F x[3], y[3];
+    for (int k = 0; k < 3; k++) {
+        F hull_x = L::set(LANDER_HULL_X[k]), hull_y = L::set(LANDER_HULL_Y[k]);
+        x[k] = L::sub(L::mul(cos_rotation, hull_x), L::mul(sin_rotation, hull_y));
+        y[k] = L::add(L::mul(sin_rotation, hull_x), L::mul(cos_rotation, hull_y));
+    }
+
+    frame.min_x = L::min(L::min(x[0], x[1]), x[2]);
+    frame.max_x = L::max(L::max(x[0], x[1]), x[2]);
+    frame.min_y = L::min(L::min(y[0], y[1]), y[2]);
+    frame.max_y = L::max(L::max(y[0], y[1]), y[2]);
+
+    for (int k = 0; k < 3; k++)
+    {
+        int next = (k + 1) % 3;
+        frame.edge_x[k] = L::sub(x[next], x[k]);
+        frame.edge_y[k] = L::sub(y[next], y[k]);
+        frame.abs_edge_x[k] = L::abs(frame.edge_x[k]);
+        frame.abs_edge_y[k] = L::abs(frame.edge_y[k]);
+
+        // Shadow on the normal (edge_y, -edge_x)
+        F shadow[3];
+        for (int v = 0; v < 3; v++) shadow[v] = L::sub(L::mul(x[v], frame.edge_y[k]), L::mul(y[v], frame.edge_x[k]));
+        frame.shadow_min[k] = L::min(L::min(shadow[0], shadow[1]), shadow[2]);
+        frame.shadow_max[k] = L::max(L::max(shadow[0], shadow[1]), shadow[2]);
+    }
+    return frame;
+}
+
+// The box is given by its centre relative to the lander and its half-size
+template <typename L>
+typename L::M hull_overlaps(const HullFrame<L>& frame, typename L::F offset_x, typename L::F offset_y,
+                            typename L::F half_width, typename L::F half_height)
+{
+    typedef typename L::F F;
+    typedef typename L::M M;
+
+    // The box's own axes first: that's the bounding-box test, and it rules out nearly everything
+    M overlap = L::and_(L::and_(L::lt(L::sub(offset_x, half_width), frame.max_x), L::lt(frame.min_x, L::add(offset_x, half_width))),
+                        L::and_(L::lt(L::sub(offset_y, half_height), frame.max_y), L::lt(frame.min_y, L::add(offset_y, half_height))));
+    if (!L::any(overlap)) return overlap;
+
+    for (int k = 0; k < 3; k++)
+    {
+        F center = L::sub(L::mul(offset_x, frame.edge_y[k]), L::mul(offset_y, frame.edge_x[k]));
+        F reach = L::add(L::mul(half_width, frame.abs_edge_y[k]), L::mul(half_height, frame.abs_edge_x[k]));
+        overlap = L::and_(overlap, L::and_(L::lt(L::sub(center, reach), frame.shadow_max[k]),
+                                           L::lt(frame.shadow_min[k], L::add(center, reach))));
+    }
+    return overlap;
+}
+
+// For a box hull_overlaps() said overlaps: the axis of the five along which the hull
+// is shallowest inside it, as a unit normal pushing the hull out, and the depth
+// along it. Plain floats only, since it's only asked about the few boxes that touch.
+inline void hull_contact(const HullFrame<ScalarLanes>& frame, float offset_x, float offset_y, float half_width,
+                         float half_height, float& normal_x, float& normal_y, float& depth)
+{
+    bool found = false;
+
+    // The hull clears the box by moving box_high - hull_low along the axis, or hull_high - box_low against it
+    auto consider = [&](float axis_x, float axis_y, float length, float hull_low, float hull_high, float center, float reach)
+    {
+        float forward = (center + reach - hull_low) / length;
+        float backward = (hull_high - (center - reach)) / length;
+        float sign = forward < backward ? 1.0f : -1.0f;
+        float along = forward < backward ? forward : backward;
+
+        if (!found || along < depth) {
+            found = true;
+            depth = along;
+            normal_x = sign * axis_x / length;
+            normal_y = sign * axis_y / length;
+        }
+    };
+
+    consider(1.0f, 0.0f, 1.0f, frame.min_x, frame.max_x, offset_x, half_width);
+    consider(0.0f, 1.0f, 1.0f, frame.min_y, frame.max_y, offset_y, half_height);
+
+    for (int k = 0; k < 3; k++)
+    {
+        float center = offset_x * frame.edge_y[k] - offset_y * frame.edge_x[k];
+        float reach = half_width * frame.abs_edge_y[k] + half_height * frame.abs_edge_x[k];
+        float length = std::sqrt(frame.edge_x[k] * frame.edge_x[k] + frame.edge_y[k] * frame.edge_y[k]);
+        consider(frame.edge_y[k], -frame.edge_x[k], length, frame.shadow_min[k], frame.shadow_max[k], center, reach);
+    }
+}
+
+#endif // LANDER_HULL_H
@@ -0,0 +1,31 @@
+#ifndef LANE_OPS_H
+#define LANE_OPS_H
+
+// The handful of operations the shared kernels (LanderHull.h, Integrator.h) are
+// written against, so one template runs on a plain float, a SIMD register of them or
+// a fixed-point number. A lane type L provides value and mask types L::F and L::M and
+// static set, add, sub, mul, min, max, abs, lt, and_ and any. min and max pick as
+// a < b ? a : b and a > b ? a : b do, which is what the SIMD instructions do too.
+//
+// ScalarLanes is here; LanderBatch.cpp has the SIMD lanes and FixedSim.cpp Q16.16 ones.
+#include <cmath>
+
+// Plain floats as single lanes
+struct ScalarLanes
+{
+    typedef float F;
+    typedef bool  M;
+
+    static F set(float x)     { return x; }
+    static F add(F a, F b)    { return a + b; }
+    static F sub(F a, F b)    { return a - b; }
+    static F mul(F a, F b)    { return a * b; }
+    static F min(F a, F b)    { return a < b ? a : b; }
+    static F max(F a, F b)    { return a > b ? a : b; }
+    static F abs(F a)         { return std::fabs(a); }
+    static M lt(F a, F b)     { return a < b; }
+    static M and_(M a, M b)   { return a && b; }
+    static bool any(M m)      { return m; }
+};
+
+#endif // LANE_OPS_H
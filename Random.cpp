@@ -0,0 +1,131 @@
+#include "Random.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define RANDOM_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RANDOM_SSE2
+#endif
+
+constexpr unsigned PHILOX_M0 = 0xD2511F53u,
+                   PHILOX_M1 = 0xCD9E8D57u,
+                   PHILOX_W0 = 0x9E3779B9u, // Golden ratio
+                   PHILOX_W1 = 0xBB67AE85u; // sqrt(3) - 1
+constexpr int PHILOX_ROUNDS = 10;
+
+void philox4x32(const unsigned counter[4], unsigned key0, unsigned key1, unsigned out[4])
+{
+    unsigned c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+
+    for (int round = 0; round < PHILOX_ROUNDS; round++)
+    {
+        unsigned long long product0 = (unsigned long long)PHILOX_M0 * c0;
+        unsigned long long product1 = (unsigned long long)PHILOX_M1 * c2;
+
+        c0 = (unsigned)(product1 >> 32) ^ c1 ^ key0;
+        c2 = (unsigned)(product0 >> 32) ^ c3 ^ key1;
+        c1 = (unsigned)product1;
+        c3 = (unsigned)product0;
+
+        key0 += PHILOX_W0;
+        key1 += PHILOX_W1;
+    }
+
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+// ————— LANE OPERATIONS ————— //
+#if defined(RANDOM_AVX2)
+struct WordLanes
+{
+    typedef __m256i V;
+    static constexpr int WIDTH = 8;
+
+    static V load(const unsigned* p)    { return _mm256_loadu_si256((const __m256i*)p); }
+    static void store(unsigned* p, V v) { _mm256_storeu_si256((__m256i*)p, v); }
+    static V set(unsigned x)            { return _mm256_set1_epi32((int)x); }
+    static V add(V a, V b)              { return _mm256_add_epi32(a, b); }
+    static V xor_(V a, V b)             { return _mm256_xor_si256(a, b); }
+
+    // Full 32x32 -> 64 bit products; mul_epu32 only covers even lanes, so odd lanes go through a shift
+    static void mul_hi_lo(V a, V m, V& hi, V& lo)
+    {
+        V even = _mm256_shuffle_epi32(_mm256_mul_epu32(a, m), _MM_SHUFFLE(3, 1, 2, 0));
+        V odd  = _mm256_shuffle_epi32(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), m), _MM_SHUFFLE(3, 1, 2, 0));
+        lo = _mm256_unpacklo_epi32(even, odd);
+        hi = _mm256_unpackhi_epi32(even, odd);
+    }
+};
+#elif defined(RANDOM_SSE2)
+struct WordLanes
+{
+    typedef __m128i V;
+    static constexpr int WIDTH = 4;
+
+    static V load(const unsigned* p)    { return _mm_loadu_si128((const __m128i*)p); }
+    static void store(unsigned* p, V v) { _mm_storeu_si128((__m128i*)p, v); }
+    static V set(unsigned x)            { return _mm_set1_epi32((int)x); }
+    static V add(V a, V b)              { return _mm_add_epi32(a, b); }
+    static V xor_(V a, V b)             { return _mm_xor_si128(a, b); }
+
+    static void mul_hi_lo(V a, V m, V& hi, V& lo)
+    {
+        V even = _mm_shuffle_epi32(_mm_mul_epu32(a, m), _MM_SHUFFLE(3, 1, 2, 0));
+        V odd  = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_epi64(a, 32), m), _MM_SHUFFLE(3, 1, 2, 0));
+        lo = _mm_unpacklo_epi32(even, odd);
+        hi = _mm_unpackhi_epi32(even, odd);
+    }
+};
+#endif
+
+void philox4x32_lanes(int count, const unsigned counter[4], unsigned key0, const unsigned* key1,
+                      unsigned* out[4])
+{
+    int i = 0;
+
+#if defined(RANDOM_AVX2) || defined(RANDOM_SSE2)
+    typedef WordLanes L;
+    typedef L::V V;
+
+    const V m0 = L::set(PHILOX_M0), m1 = L::set(PHILOX_M1);
+    const V w0 = L::set(PHILOX_W0), w1 = L::set(PHILOX_W1);
+
+    for (; i + L::WIDTH <= count; i += L::WIDTH)
+    {
+        V c0 = L::set(counter[0]), c1 = L::set(counter[1]), c2 = L::set(counter[2]), c3 = L::set(counter[3]);
+        V k0 = L::set(key0), k1 = L::load(key1 + i);
+
+        for (int round = 0; round < PHILOX_ROUNDS; round++)
+        {
+            V hi0, lo0, hi1, lo1;
+            L::mul_hi_lo(c0, m0, hi0, lo0);
+            L::mul_hi_lo(c2, m1, hi1, lo1);
+
+            c0 = L::xor_(L::xor_(hi1, c1), k0);
+            c2 = L::xor_(L::xor_(hi0, c3), k1);
+            c1 = lo1;
+            c3 = lo0;
+
+            k0 = L::add(k0, w0);
+            k1 = L::add(k1, w1);
+        }
+
+        L::store(out[0] + i, c0);
+        L::store(out[1] + i, c1);
+        L::store(out[2] + i, c2);
+        L::store(out[3] + i, c3);
+    }
+#endif
+
+    // Whatever doesn't fill a whole register
+    for (; i < count; i++)
+    {
+        unsigned block[4];
+        philox4x32(counter, key0, key1[i], block);
+        for (int w = 0; w < 4; w++) out[w][i] = block[w];
+    }
+}
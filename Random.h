@@ -0,0 +1,22 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+// Philox4x32-10 counter-based generator (Salmon et al., "Parallel random numbers:
+// as easy as 1, 2, 3"). Output is a pure function of (counter, key), so every
+// environment can be keyed by its seed and episode id and draw without any shared
+// state, from any thread, in any order.
+
+// ————— SINGLE STREAM ————— //
+void philox4x32(const unsigned counter[4], unsigned key0, unsigned key1, unsigned out[4]);
+
+// ————— MANY STREAMS ————— //
+// One block per lane for lanes [0, count): all lanes share counter and key0 while
+// key1 varies per lane. Word w of lane i lands in out[w][i]. Runs 8 (AVX2) or 4
+// (SSE2) lanes at a time and gives the same bits as philox4x32 lane by lane.
+void philox4x32_lanes(int count, const unsigned counter[4], unsigned key0, const unsigned* key1,
+                      unsigned* out[4]);
+
+// Top 24 bits as a float in [0, 1), exact and identical on every platform
+inline float random_unit(unsigned bits) { return (float)(bits >> 8) * (1.0f / 16777216.0f); }
+
+#endif // RANDOM_H
@@ -0,0 +1,240 @@
+#define GL_SILENCE_DEPRECATION
+#define STB_IMAGE_IMPLEMENTATION
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "Render.h"
+#include "LanderHull.h"
+#include "Simulation.h"
+#include "stb_image.h"
+#include <cassert>
+#include <iostream>
+
+GLuint load_texture(const char* filepath) {
+    int width, height, number_of_components;
+    unsigned char* image = stbi_load(filepath, &width, &height, &number_of_components, STBI_rgb_alpha);
+
+    if (image == NULL) {
+        std::cerr << "Unable to load image. Make sure the path is correct.\n";
+        assert(false);
+    }
+
+    GLuint texture_id;
+    glGenTextures(1, &texture_id);
+    glBindTexture(GL_TEXTURE_2D, texture_id);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    stbi_image_free(image);
+
+    return texture_id;
+}
+
+void build_text_mesh(const std::string& text, float font_size, float spacing,
+                     std::vector<float>& vertices, std::vector<float>& texture_coordinates) {
+    // Scale the size of the fontbank in the UV-plane
+    float width = 1.0f / FONTBANK_SIZE;
+    float height = 1.0f / FONTBANK_SIZE;
+
+    // For every character in the text
+    for (size_t i = 0; i < text.size(); i++) {
+        // Get the ASCII value of the character
+        int spritesheet_index = (int)text[i];
+        float offset = (font_size + spacing) * i;
+
+        // Calculate the UV coordinates in the font texture
+        float u_coordinate = (float)(spritesheet_index % FONTBANK_SIZE) / FONTBANK_SIZE;
+        float v_coordinate = (float)(spritesheet_index / FONTBANK_SIZE) / FONTBANK_SIZE;
+
+        // Add the vertices for the character (two triangles to form a quad)
+        vertices.insert(vertices.end(), {
+            offset + (-0.5f * font_size), 0.5f * font_size,
+            offset + (-0.5f * font_size), -0.5f * font_size,
+            offset + (0.5f * font_size), 0.5f * font_size,
+            offset + (0.5f * font_size), -0.5f * font_size,
+            offset + (0.5f * font_size), 0.5f * font_size,
+            offset + (-0.5f * font_size), -0.5f * font_size,
+            });
+
+        // Add the texture coordinates for the character
+        texture_coordinates.insert(texture_coordinates.end(), {
+            u_coordinate, v_coordinate,
+            u_coordinate, v_coordinate + height,
+            u_coordinate + width, v_coordinate,
+            u_coordinate + width, v_coordinate + height,
+            u_coordinate + width, v_coordinate,
+            u_coordinate, v_coordinate + height,
+            });
+    }
+}
+
+void draw_text(ShaderProgram* program, GLuint font_texture_id, std::string text, float font_size, float spacing, glm::vec3 position) {
+    // Arrays to hold the data for the vertices and texture coordinates
+    std::vector<float> vertices;
+    std::vector<float> texture_coordinates;
+    build_text_mesh(text, font_size, spacing, vertices, texture_coordinates);
+
+    // Create a model matrix for the text
+    glm::mat4 model_matrix = glm::mat4(1.0f);
+    model_matrix = glm::translate(model_matrix, position);
+
+    // Set the model matrix and render the text
+    program->set_model_matrix(model_matrix);
+
+    // Bind the texture and set up the vertex attributes
+    glBindTexture(GL_TEXTURE_2D, font_texture_id);
+
+    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices.data());
+    glEnableVertexAttribArray(program->get_position_attribute());
+
+    glVertexAttribPointer(program->get_tex_coordinate_attribute(), 2, GL_FLOAT, false, 0, texture_coordinates.data());
+    glEnableVertexAttribArray(program->get_tex_coordinate_attribute());
+
+    // Draw the text
+    glDrawArrays(GL_TRIANGLES, 0, (int)(text.size() * 6));
+
+    // Disable the vertex attributes
+    glDisableVertexAttribArray(program->get_position_attribute());
+    glDisableVertexAttribArray(program->get_tex_coordinate_attribute());
+}
+
+void draw_lander(ShaderProgram* program, glm::vec3 position, float rotation) {
+    glm::mat4 model_matrix = glm::mat4(1.0f);
+    model_matrix = glm::translate(model_matrix, position);
+
+    // Apply rotation - rotate around the Z axis
+    model_matrix = glm::rotate(model_matrix, glm::radians(rotation), glm::vec3(0.0f, 0.0f, 1.0f));
+
+    program->set_model_matrix(model_matrix);
+
+    // Set lander color (white)
+    program->set_colour(1.0f, 1.0f, 1.0f, 1.0f);
+
+    // Draw lander as a triangle: the same hull the simulation collides with
+    float vertices[] = {
+        LANDER_HULL_X[0], LANDER_HULL_Y[0], // top
+        LANDER_HULL_X[1], LANDER_HULL_Y[1], // bottom left
+        LANDER_HULL_X[2], LANDER_HULL_Y[2]  // bottom right
+    };
+
+    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices);
+    glEnableVertexAttribArray(program->get_position_attribute());
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glDisableVertexAttribArray(program->get_position_attribute());
+}
+
+// Function to draw a platform
+void draw_platform(ShaderProgram* program, glm::vec3 position, float width, float height, bool is_landing_zone) {
+    glm::mat4 model_matrix = glm::mat4(1.0f);
+    model_matrix = glm::translate(model_matrix, position);
+    program->set_model_matrix(model_matrix);
+
+    // Set platform color (green for landing zone, red for obstacles)
+    if (is_landing_zone) {
+        program->set_colour(0.0f, 1.0f, 0.0f, 1.0f); // Green
+    }
+    else {
+        program->set_colour(1.0f, 0.0f, 0.0f, 1.0f); // Red
+    }
+
+    // Draw platform as a rectangle
+    float half_width = width / 2.0f;
+    float half_height = height / 2.0f;
+
+    float vertices[] = {
+        -half_width, -half_height, // bottom left
+        half_width, -half_height,  // bottom right
+        half_width, half_height,   // top right
+
+        -half_width, -half_height, // bottom left
+        half_width, half_height,   // top right
+        -half_width, half_height   // top left
+    };
+
+    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices);
+    glEnableVertexAttribArray(program->get_position_attribute());
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDisableVertexAttribArray(program->get_position_attribute());
+}
+
+void draw_asteroid(ShaderProgram* program, glm::vec3 position, float size) {
+    glm::mat4 model_matrix = glm::mat4(1.0f);
+    model_matrix = glm::translate(model_matrix, position);
+    program->set_model_matrix(model_matrix);
+
+    // Set asteroid color (gray)
+    program->set_colour(0.5f, 0.5f, 0.5f, 1.0f);
+
+    // Draw asteroid as a simple square instead of a complex shape
+    float half_size = size / 2.0f;
+
+    float vertices[] = {
+        -half_size, -half_size, // bottom left
+        half_size, -half_size,  // bottom right
+        half_size, half_size,   // top right
+
+        -half_size, -half_size, // bottom left
+        half_size, half_size,   // top right
+        -half_size, half_size   // top left
+    };
+
+    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, vertices);
+    glEnableVertexAttribArray(program->get_position_attribute());
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDisableVertexAttribArray(program->get_position_attribute());
+}
+
+void draw_fuel_gauge(ShaderProgram* program, float fuel_level) {
+    glm::mat4 model_matrix = glm::mat4(1.0f);
+    model_matrix = glm::translate(model_matrix, glm::vec3(-4.5f, 3.5f, 0.0f));
+    program->set_model_matrix(model_matrix);
+
+    // Draw fuel background (gray)
+    program->set_colour(0.3f, 0.3f, 0.3f, 1.0f);
+
+    float bg_vertices[] = {
+        0.0f, 0.0f,    // bottom left
+        3.0f, 0.0f,    // bottom right
+        3.0f, 0.3f,    // top right
+
+        0.0f, 0.0f,    // bottom left
+        3.0f, 0.3f,    // top right
+        0.0f, 0.3f     // top left
+    };
+
+    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, bg_vertices);
+    glEnableVertexAttribArray(program->get_position_attribute());
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDisableVertexAttribArray(program->get_position_attribute());
+
+    // Draw fuel level (yellow)
+    program->set_colour(1.0f, 1.0f, 0.0f, 1.0f);
+
+    float fuel_width = (fuel_level / MAX_FUEL) * 3.0f;
+
+    float fuel_vertices[] = {
+        0.0f, 0.0f,        // bottom left
+        fuel_width, 0.0f,  // bottom right
+        fuel_width, 0.3f,  // top right
+
+        0.0f, 0.0f,        // bottom left
+        fuel_width, 0.3f,  // top right
+        0.0f, 0.3f         // top left
+    };
+
+    glVertexAttribPointer(program->get_position_attribute(), 2, GL_FLOAT, false, 0, fuel_vertices);
+    glEnableVertexAttribArray(program->get_position_attribute());
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glDisableVertexAttribArray(program->get_position_attribute());
+}
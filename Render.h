@@ -0,0 +1,29 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+// Drawing helpers for the lander scene. Each call sets its own model matrix and
+// colour, so they can be issued in any order.
+#include "glm/glm.hpp"
+#include "ShaderProgram.h"
+#include <string>
+#include <vector>
+
+constexpr int FONTBANK_SIZE = 16; // Font sprite sheet is 16x16 characters
+
+GLuint load_texture(const char* filepath);
+
+// ————— TEXT ————— //
+// Two triangles per character, laid out left to right from the origin. Appends
+// 12 position floats and 12 texture coordinates per character.
+void build_text_mesh(const std::string& text, float font_size, float spacing,
+                     std::vector<float>& vertices, std::vector<float>& texture_coordinates);
+
+void draw_text(ShaderProgram* program, GLuint font_texture_id, std::string text, float font_size, float spacing, glm::vec3 position);
+
+// ————— SCENE ————— //
+void draw_lander(ShaderProgram* program, glm::vec3 position, float rotation);
+void draw_platform(ShaderProgram* program, glm::vec3 position, float width, float height, bool is_landing_zone);
+void draw_asteroid(ShaderProgram* program, glm::vec3 position, float size);
+void draw_fuel_gauge(ShaderProgram* program, float fuel_level);
+
+#endif // RENDER_H
@@ -0,0 +1,130 @@
+#include "Replay.h"
+#include <fstream>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// ————— RECORDING ————— //
+ReplayRecorder::ReplayRecorder()
+{
+    begin(0, 0);
+}
+
+void ReplayRecorder::begin(unsigned seed, unsigned episode)
+{
+    m_header.magic = REPLAY_MAGIC;
+    m_header.version = REPLAY_VERSION;
+    m_header.seed = seed;
+    m_header.episode = episode;
+    m_header.tick_count = 0;
+    m_header.run_count = 0;
+    m_runs.clear();
+}
+
+void ReplayRecorder::record(unsigned input)
+{
+    input &= REPLAY_INPUT_MASK;
+
+    // Extend the current run while the same controls stay held
+    if (!m_runs.empty() && replay_run_input(m_runs.back()) == input && replay_run_length(m_runs.back()) < REPLAY_MAX_RUN) {
+        m_runs.back() += 1u << REPLAY_INPUT_BITS;
+    }
+    else {
+        m_runs.push_back((1u << REPLAY_INPUT_BITS) | input);
+    }
+
+    m_header.tick_count++;
+    m_header.run_count = (std::uint32_t)m_runs.size();
+}
+
+bool ReplayRecorder::save(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    file.write((const char*)&m_header, sizeof(m_header));
+    file.write((const char*)m_runs.data(), m_runs.size() * sizeof(std::uint32_t));
+    return (bool)file;
+}
+
+// ————— PLAYBACK ————— //
+ReplayFile::~ReplayFile()
+{
+    close();
+}
+
+void ReplayFile::close()
+{
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle((HANDLE)m_mapping);
+    if (m_file) CloseHandle((HANDLE)m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    if (m_data) munmap((void*)m_data, m_size);
+    if (m_file >= 0) ::close(m_file);
+    m_file = -1;
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool ReplayFile::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    m_file = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(ReplayHeader)) { close(); return false; }
+    m_size = (std::size_t)size.QuadPart;
+
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mapping) { close(); return false; }
+
+    m_data = (const unsigned char*)MapViewOfFile((HANDLE)m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!m_data) { close(); return false; }
+#else
+    m_file = ::open(path.c_str(), O_RDONLY);
+    if (m_file < 0) return false;
+
+    struct stat info;
+    if (fstat(m_file, &info) != 0 || info.st_size < (off_t)sizeof(ReplayHeader)) { close(); return false; }
+    m_size = (std::size_t)info.st_size;
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+    if (data == MAP_FAILED) { close(); return false; }
+    m_data = (const unsigned char*)data;
+#endif
+
+    // Reject anything that isn't a complete replay of this version
+    const ReplayHeader& header = get_header();
+    if (header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION ||
+        m_size < sizeof(ReplayHeader) + (std::size_t)header.run_count * sizeof(std::uint32_t)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void replay_play(const ReplayHeader& header, const std::uint32_t* runs, SimState& state)
+{
+    sim_init(state, header.seed, header.episode);
+
+    for (std::uint32_t r = 0; r < header.run_count && !state.game_over; r++) {
+        sim_step_held(state, replay_run_input(runs[r]), replay_run_length(runs[r]));
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+// Compact input replays. A replay is the level key (seed, episode) plus the
+// per-tick LanderInput masks, run-length encoded: each run is one 32-bit word
+// holding the mask in its low REPLAY_INPUT_BITS bits and the number of ticks it
+// was held for above them. Since the simulation is deterministic, that is all it
+// takes to reproduce an episode exactly.
+//
+// File layout: ReplayHeader, then header.run_count run words.
+#include "Simulation.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr int           REPLAY_INPUT_BITS = 3;
+constexpr std::uint32_t REPLAY_INPUT_MASK = (1u << REPLAY_INPUT_BITS) - 1;
+constexpr std::uint32_t REPLAY_MAX_RUN    = 0xFFFFFFFFu >> REPLAY_INPUT_BITS;
+constexpr std::uint32_t REPLAY_MAGIC      = 0x50524C4Cu; // "LLRP" read as little-endian
+constexpr std::uint32_t REPLAY_VERSION    = 2; // 2: collisions use the lander's hull
+
+struct ReplayHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t seed;
+    std::uint32_t episode;
+    std::uint32_t tick_count;
+    std::uint32_t run_count;
+};
+
+inline std::uint32_t replay_run_input(std::uint32_t run)  { return run & REPLAY_INPUT_MASK; }
+inline std::uint32_t replay_run_length(std::uint32_t run) { return run >> REPLAY_INPUT_BITS; }
+
+// ————— RECORDING ————— //
+class ReplayRecorder
+{
+private:
+    ReplayHeader               m_header;
+    std::vector<std::uint32_t> m_runs;
+
+public:
+    ReplayRecorder();
+
+    void begin(unsigned seed, unsigned episode);
+    void record(unsigned input); // Call once per simulated tick
+
+    bool save(const std::string& path) const;
+
+    const ReplayHeader& get_header() const { return m_header; }
+    const std::vector<std::uint32_t>& get_runs() const { return m_runs; }
+};
+
+// ————— PLAYBACK ————— //
+// Maps a replay file read-only, so playback reads the runs straight from the page cache
+class ReplayFile
+{
+private:
+    const unsigned char* m_data = nullptr;
+    std::size_t          m_size = 0;
+#ifdef _WIN32
+    void* m_file    = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int   m_file    = -1;
+#endif
+
+    void close();
+
+public:
+    ReplayFile() = default;
+    ~ReplayFile();
+    ReplayFile(const ReplayFile&) = delete;
+    ReplayFile& operator=(const ReplayFile&) = delete;
+
+    // False if the file can't be mapped or isn't a replay this build understands
+    bool open(const std::string& path);
+
+    bool is_open() const { return m_data != nullptr; }
+    const ReplayHeader& get_header() const { return *(const ReplayHeader*)m_data; }
+    const std::uint32_t* get_runs() const { return (const std::uint32_t*)(m_data + sizeof(ReplayHeader)); }
+};
+
+// Walks a run list one tick at a time
+class ReplayCursor
+{
+private:
+    const std::uint32_t* m_runs;
+    std::uint32_t        m_run_count;
+    std::uint32_t        m_run      = 0;
+    std::uint32_t        m_run_tick = 0;
+
+public:
+    ReplayCursor(const std::uint32_t* runs, std::uint32_t run_count) : m_runs(runs), m_run_count(run_count) {}
+
+    bool is_done() const { return m_run >= m_run_count; }
+
+    // The input for the next tick; INPUT_NONE once the replay has run out
+    unsigned next()
+    {
+        if (is_done()) return INPUT_NONE;
+
+        unsigned input = replay_run_input(m_runs[m_run]);
+        if (++m_run_tick >= replay_run_length(m_runs[m_run])) {
+            m_run++;
+            m_run_tick = 0;
+        }
+        return input;
+    }
+};
+
+// Rebuilds the replay's level and feeds it every recorded input as fast as possible
+void replay_play(const ReplayHeader& header, const std::uint32_t* runs, SimState& state);
+
+#endif // REPLAY_H
@@ -0,0 +1,141 @@
+#include "RolloutRunner.h"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace
+{
+    // A worker's remaining episodes [begin, end) packed into one word, so the owner
+    // claiming from the front and thieves splitting off the back can never both win
+    struct alignas(64) WorkSlice
+    {
+        std::atomic<std::uint64_t> range;
+    };
+
+    std::uint64_t pack(std::uint32_t begin, std::uint32_t end) { return ((std::uint64_t)begin << 32) | end; }
+    std::uint32_t range_begin(std::uint64_t range) { return (std::uint32_t)(range >> 32); }
+    std::uint32_t range_end(std::uint64_t range) { return (std::uint32_t)range; }
+
+    bool claim_front(WorkSlice& slice, std::uint32_t grain, std::uint32_t& begin, std::uint32_t& end)
+    {
+        std::uint64_t range = slice.range.load();
+        while (range_begin(range) < range_end(range))
+        {
+            begin = range_begin(range);
+            end = range_end(range) - begin > grain ? begin + grain : range_end(range);
+            if (slice.range.compare_exchange_weak(range, pack(end, range_end(range)))) return true;
+        }
+        return false;
+    }
+
+    bool steal_back(WorkSlice& victim, std::uint32_t& begin, std::uint32_t& end)
+    {
+        std::uint64_t range = victim.range.load();
+        while (range_begin(range) < range_end(range))
+        {
+            std::uint32_t middle = range_begin(range) + (range_end(range) - range_begin(range)) / 2;
+            begin = middle;
+            end = range_end(range);
+            if (victim.range.compare_exchange_weak(range, pack(range_begin(range), middle))) return true;
+        }
+        return false;
+    }
+}
+
+RolloutRunner::RolloutRunner(int worker_count)
+    : m_worker_count(worker_count), m_grain(64), m_ticks_per_step(1), m_adaptive(false)
+{
+    if (m_worker_count <= 0) m_worker_count = (int)std::thread::hardware_concurrency();
+    if (m_worker_count <= 0) m_worker_count = 1;
+}
+
+EpisodeOutcome RolloutRunner::run_episode(unsigned seed, LanderPolicy policy, void* user_data, unsigned max_ticks,
+                                          int ticks_per_step, bool adaptive)
+{
+    SimState state;
+    sim_init(state, seed);
+    SimSubstepCounters substeps = {};
+
+    if (ticks_per_step > 1 && adaptive) {
+        // Coarse through empty space, down to single ticks near anything
+        while (!state.game_over && state.tick < max_ticks) {
+            sim_step_adaptive(state, policy(state, user_data), ticks_per_step, substeps);
+        }
+    }
+    else if (ticks_per_step > 1) {
+        // Coarse evaluation: swept steps keep the outcomes while skipping the in-between ticks
+        while (!state.game_over && state.tick < max_ticks) {
+            sim_step_swept(state, policy(state, user_data), ticks_per_step);
+        }
+    }
+    else {
+        while (!state.game_over && state.tick < max_ticks) {
+            sim_step(state, policy(state, user_data));
+        }
+    }
+
+    EpisodeOutcome outcome;
+    outcome.seed = seed;
+    outcome.status = state.game_over ? state.status : RUNNING;
+    outcome.ticks = state.tick;
+    outcome.fuel = state.fuel;
+    outcome.position = state.position;
+    outcome.velocity = state.velocity;
+    outcome.substeps = substeps;
+    return outcome;
+}
+
+std::vector<EpisodeOutcome> RolloutRunner::run(const std::vector<unsigned>& seeds, LanderPolicy policy,
+                                               void* user_data, unsigned max_ticks) const
+{
+    std::vector<EpisodeOutcome> outcomes(seeds.size());
+    const std::uint32_t episode_count = (std::uint32_t)seeds.size();
+    int worker_count = m_worker_count;
+    if ((std::uint32_t)worker_count > episode_count) worker_count = (int)episode_count;
+    if (worker_count < 1) worker_count = 1;
+    const std::uint32_t grain = (std::uint32_t)m_grain;
+
+    // Hand every worker an equal slice up front; stealing evens out the rest
+    std::vector<WorkSlice> slices(worker_count);
+    for (int w = 0; w < worker_count; w++) {
+        std::uint32_t begin = (std::uint32_t)((std::uint64_t)episode_count * w / worker_count);
+        std::uint32_t end = (std::uint32_t)((std::uint64_t)episode_count * (w + 1) / worker_count);
+        slices[w].range.store(pack(begin, end));
+    }
+
+    auto work = [&](int self)
+    {
+        std::uint32_t begin, end;
+        for (;;)
+        {
+            while (claim_front(slices[self], grain, begin, end)) {
+                for (std::uint32_t i = begin; i < end; i++) {
+                    outcomes[i] = run_episode(seeds[i], policy, user_data, max_ticks, m_ticks_per_step, m_adaptive);
+                }
+            }
+
+            // Own slice is dry: split the fullest remaining slice and keep its back half.
+            // Nobody adds work after the start, so finding every slice empty means we're done.
+            int victim = -1;
+            std::uint32_t most = 0;
+            for (int w = 0; w < worker_count; w++) {
+                std::uint64_t range = slices[w].range.load();
+                std::uint32_t left = range_end(range) - range_begin(range);
+                if (w != self && range_begin(range) < range_end(range) && left > most) {
+                    most = left;
+                    victim = w;
+                }
+            }
+            if (victim < 0) return;
+
+            if (steal_back(slices[victim], begin, end)) slices[self].range.store(pack(begin, end));
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < worker_count; w++) workers.emplace_back(work, w);
+    work(0);
+    for (std::thread& worker : workers) worker.join();
+
+    return outcomes;
+}
@@ -0,0 +1,58 @@
+#ifndef ROLLOUT_RUNNER_H
+#define ROLLOUT_RUNNER_H
+
+// Runs many independent episodes across all cores. Every worker owns its own
+// SimState, and episodes are handed out by work stealing: each worker starts
+// with an equal slice of the episode range and, once its slice runs dry,
+// takes the back half of whichever other worker has the most left.
+#include "Simulation.h"
+#include <vector>
+
+// What one episode ended as, recorded against the seed that laid out its level
+struct EpisodeOutcome
+{
+    unsigned   seed;
+    GameStatus status; // RUNNING if the episode hit the tick limit
+    unsigned   ticks;
+    float      fuel;
+    glm::vec3  position;
+    glm::vec3  velocity;
+    SimSubstepCounters substeps; // All zero unless the episode ran adaptive steps
+};
+
+// Picks the controls to hold for the next tick. Called from worker threads, so
+// anything reached through user_data must be safe to read concurrently.
+typedef unsigned (*LanderPolicy)(const SimState& state, void* user_data);
+
+class RolloutRunner
+{
+private:
+    int m_worker_count;
+    int m_grain;          // Episodes a worker claims from its own slice at a time
+    int m_ticks_per_step; // > 1: hold each action this many ticks and take them as one sim_step_swept
+    bool m_adaptive;      // Take those held actions as sim_step_adaptive instead
+
+public:
+    // ————— METHODS ————— //
+    explicit RolloutRunner(int worker_count = 0); // 0 = one worker per hardware thread
+
+    // Plays one episode per seed and returns their outcomes in the same order as seeds
+    std::vector<EpisodeOutcome> run(const std::vector<unsigned>& seeds, LanderPolicy policy,
+                                    void* user_data, unsigned max_ticks) const;
+
+    // Plays a single episode on the calling thread
+    static EpisodeOutcome run_episode(unsigned seed, LanderPolicy policy, void* user_data, unsigned max_ticks,
+                                      int ticks_per_step = 1, bool adaptive = false);
+
+    // ————— GETTERS ————— //
+    int get_worker_count() const { return m_worker_count; }
+    int get_ticks_per_step() const { return m_ticks_per_step; }
+    bool get_adaptive() const { return m_adaptive; }
+
+    // ————— SETTERS ————— //
+    void set_grain(int new_grain) { m_grain = new_grain > 0 ? new_grain : 1; }
+    void set_ticks_per_step(int new_ticks) { m_ticks_per_step = new_ticks > 0 ? new_ticks : 1; }
+    void set_adaptive(bool new_adaptive) { m_adaptive = new_adaptive; }
+};
+
+#endif // ROLLOUT_RUNNER_H
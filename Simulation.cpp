@@ -0,0 +1,436 @@
+#include "Simulation.h"
+#include "LanderHull.h"
+#include <algorithm>
+#include <cmath>
+
+void sim_place_platforms(SimBox platforms[PLATFORM_COUNT])
+{
+    for (int i = 0; i < PLATFORM_COUNT; i++) {
+        platforms[i].position = glm::vec3(platform_x(i), PLATFORM_Y, 0.0f);
+        platforms[i].width = PLATFORM_WIDTH;
+        platforms[i].height = PLATFORM_HEIGHT;
+    }
+}
+
+static void place_asteroid(SimBox& asteroid, float randomX, float randomY)
+{
+    asteroid.position = glm::vec3(randomX, randomY, 0.0f);
+    asteroid.width = ASTEROID_SIZE;
+    asteroid.height = ASTEROID_SIZE;
+}
+
+void sim_random(SimState& state, unsigned out[4])
+{
+    unsigned counter[4] = { state.rng_counter++, 0, 0, 0 };
+    philox4x32(counter, state.rng_key[0], state.rng_key[1], out);
+}
+
+void sim_init(SimState& state, unsigned seed, unsigned episode)
+{
+    sim_place_platforms(state.platforms);
+
+    state.rng_key[0] = seed;
+    state.rng_key[1] = episode;
+    state.rng_counter = 0;
+
+    for (int i = 0; i < ASTEROID_COUNT; i++) {
+        unsigned block[4];
+        sim_random(state, block);
+        place_asteroid(state.asteroids[i], asteroid_x_from(block[0]), asteroid_y_from(block[1]));
+    }
+
+    state.time_accumulator = 0.0f;
+    sim_reset(state);
+}
+
+void sim_reset(SimState& state)
+{
+    state.position = glm::vec3(LANDER_START_X, LANDER_START_Y, 0.0f);
+    state.velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+    state.acceleration = glm::vec3(0.0f, GRAVITY, 0.0f); // Initial acceleration is just gravity
+    state.fuel = MAX_FUEL;
+    state.rotation = 0.0f;
+
+    state.status = RUNNING;
+    state.game_over = false;
+    state.tick = 0;
+}
+
+void sim_apply_input(SimState& state, unsigned input)
+{
+    // Reset acceleration to just gravity
+    state.acceleration = glm::vec3(0.0f, GRAVITY, 0.0f);
+
+    if (input & INPUT_LEFT) {
+        if (state.fuel > 0) {
+            state.acceleration.x -= ACCELERATION_X;
+            state.fuel -= FUEL_CONSUMPTION_RATE * FIXED_TIMESTEP;
+
+            // Rotate lander slightly to indicate direction
+            state.rotation = LANDER_TILT;
+        }
+    }
+    else if (input & INPUT_RIGHT) {
+        if (state.fuel > 0) {
+            state.acceleration.x += ACCELERATION_X;
+            state.fuel -= FUEL_CONSUMPTION_RATE * FIXED_TIMESTEP;
+
+            state.rotation = -LANDER_TILT;
+        }
+    }
+    else {
+        // Reset rotation when not moving horizontally
+        state.rotation = 0.0f;
+    }
+
+    // Upward thrust is checked against whatever fuel the sideways burn left
+    if (input & INPUT_THRUST) {
+        if (state.fuel > 0) {
+            state.acceleration.y += ACCELERATION_Y;
+            state.fuel -= FUEL_CONSUMPTION_RATE * FIXED_TIMESTEP;
+        }
+    }
+
+    // Ensure fuel doesn't go below 0
+    if (state.fuel < 0) state.fuel = 0;
+}
+
+bool sim_check_collision(glm::vec3 position, float width, float height, const SimBox& other)
+{
+    float x_distance = std::fabs(position.x - other.position.x) - ((width + other.width) / 2.0f);
+    float y_distance = std::fabs(position.y - other.position.y) - ((height + other.height) / 2.0f);
+
+    return x_distance < 0.0f && y_distance < 0.0f;
+}
+
+void sim_hull_rotation(float rotation, float& cos_rotation, float& sin_rotation)
+{
+    if (rotation == 0.0f) {
+        cos_rotation = 1.0f;
+        sin_rotation = 0.0f;
+    }
+    else if (rotation == LANDER_TILT || rotation == -LANDER_TILT) {
+        cos_rotation = LANDER_TILT_COS;
+        sin_rotation = rotation > 0.0f ? LANDER_TILT_SIN : -LANDER_TILT_SIN;
+    }
+    else {
+        float radians = glm::radians(rotation);
+        cos_rotation = std::cos(radians);
+        sin_rotation = std::sin(radians);
+    }
+}
+
+static HullFrame<ScalarLanes> hull_frame_for(float rotation)
+{
+    float cos_rotation, sin_rotation;
+    sim_hull_rotation(rotation, cos_rotation, sin_rotation);
+    return hull_frame<ScalarLanes>(cos_rotation, sin_rotation);
+}
+
+static bool hull_overlaps_box(const HullFrame<ScalarLanes>& hull, glm::vec3 position, const SimBox& other)
+{
+    return hull_overlaps<ScalarLanes>(hull, other.position.x - position.x, other.position.y - position.y,
+                                      other.width / 2.0f, other.height / 2.0f);
+}
+
+// Cheap test that rules a box out whatever the hull's rotation
+static bool hull_might_touch(glm::vec3 position, const SimBox& other)
+{
+    return std::fabs(position.x - other.position.x) < LANDER_HULL_RADIUS + other.width / 2.0f &&
+           std::fabs(position.y - other.position.y) < LANDER_HULL_RADIUS + other.height / 2.0f;
+}
+
+bool sim_check_hull_collision(glm::vec3 position, float rotation, const SimBox& other)
+{
+    return hull_overlaps_box(hull_frame_for(rotation), position, other);
+}
+
+static void integrate(SimState& state)
+{
+    // Apply acceleration to velocity, with a little horizontal damping for better control
+    integrate_axis<ScalarLanes>(INTEGRATOR_SEMI_IMPLICIT_EULER, LANDER_STEP_X, state.position.x, state.velocity.x, state.acceleration.x);
+    integrate_axis<ScalarLanes>(INTEGRATOR_SEMI_IMPLICIT_EULER, LANDER_STEP_Y, state.position.y, state.velocity.y, state.acceleration.y);
+}
+
+// The narrowphase: a contact for every box the hull overlaps, platforms first, then
+// asteroids. found needs room for every box in the level.
+static int find_contacts(const SimState& state, Contact* found)
+{
+    // Nearly every tick the lander is nowhere near a box, and the hull needn't be worked out
+    bool near = false;
+    for (int i = 0; i < PLATFORM_COUNT; i++) near = near || hull_might_touch(state.position, state.platforms[i]);
+    for (int i = 0; i < ASTEROID_COUNT; i++) near = near || hull_might_touch(state.position, state.asteroids[i]);
+    if (!near) return 0;
+
+    HullFrame<ScalarLanes> hull = hull_frame_for(state.rotation);
+    int count = 0;
+
+    for (int b = 0; b < PLATFORM_COUNT + ASTEROID_COUNT; b++)
+    {
+        const SimBox& other = b < PLATFORM_COUNT ? state.platforms[b] : state.asteroids[b - PLATFORM_COUNT];
+        if (!hull_overlaps_box(hull, state.position, other)) continue;
+
+        Contact& contact = found[count++];
+        contact.a = BODY_LANDER;
+        contact.b = BODY_PLATFORM + b; // Asteroids follow on straight after the platforms
+        contact.normal = glm::vec3(0.0f);
+        hull_contact(hull, other.position.x - state.position.x, other.position.y - state.position.y,
+                     other.width / 2.0f, other.height / 2.0f, contact.normal.x, contact.normal.y, contact.depth);
+        contact.relative_velocity = state.velocity; // Boxes never move
+    }
+    return count;
+}
+
+// The win/loss rules, read off this tick's contacts and the lander's position
+static void apply_rules(SimState& state, const Contact* contacts, int count)
+{
+    // Touching any platform ends the run; only a gentle touchdown on the landing zone wins
+    for (int c = 0; c < count; c++) {
+        const Contact& contact = contacts[c];
+        if (contact.b == BODY_PLATFORM + LANDING_ZONE &&
+            std::fabs(contact.relative_velocity.y) < LANDING_MAX_SPEED_Y &&
+            std::fabs(contact.relative_velocity.x) < LANDING_MAX_SPEED_X) {
+            state.status = MISSION_ACCOMPLISHED;
+        }
+        else {
+            state.status = MISSION_FAILED;
+        }
+        state.game_over = true;
+    }
+
+    // Check if player is out of bounds
+    if (state.position.y < WORLD_BOTTOM || state.position.x < WORLD_LEFT || state.position.x > WORLD_RIGHT) {
+        state.status = MISSION_FAILED;
+        state.game_over = true;
+    }
+}
+
+// Both sim_steps: the tick's contacts also go to contacts, when given
+static void step(SimState& state, unsigned input, ContactList* contacts)
+{
+    // If game is over, don't update physics
+    if (state.game_over) return;
+
+    sim_apply_input(state, input);
+    integrate(state);
+
+    Contact found[PLATFORM_COUNT + ASTEROID_COUNT];
+    int count = find_contacts(state, found);
+    apply_rules(state, found, count);
+    if (contacts) contacts->insert(contacts->end(), found, found + count);
+
+    state.tick++;
+}
+
+void sim_step(SimState& state, unsigned input)
+{
+    step(state, input, nullptr);
+}
+
+void sim_step(SimState& state, unsigned input, ContactList& contacts)
+{
+    step(state, input, &contacts);
+}
+
+// ————— HELD INPUT ————— //
+// Whether a lander moving from here under a constant acceleration is sure to spend the
+// next ticks clear of every box and inside the world. Its path is bounded in closed form,
+// in double precision, and widened by COAST_MARGIN to cover the rounding sim_step's
+// floats pick up on the way.
+static bool path_is_clear(const SimState& state, glm::vec3 acceleration, unsigned ticks)
+{
+    const double dt = FIXED_TIMESTEP, n = ticks;
+    const double x = state.position.x, y = state.position.y;
+    const double vx = state.velocity.x, vy = state.velocity.y;
+    const double ax = acceleration.x, ay = acceleration.y;
+
+    // y after k ticks is y + dt * (k * vy + ay * dt * k * (k + 1) / 2): a parabola in k
+    auto height_after = [&](double k) { return y + dt * (k * vy + ay * dt * k * (k + 1.0) / 2.0); };
+    double min_y = std::min(y, height_after(n)), max_y = std::max(y, height_after(n));
+    if (ay != 0.0) {
+        double turn = -vy / (ay * dt) - 0.5;
+        if (turn > 0.0 && turn < n) {
+            min_y = std::min(min_y, height_after(turn));
+            max_y = std::max(max_y, height_after(turn));
+        }
+    }
+
+    // Damping only ever slows x down, so no tick is faster than |vx| + k |ax| dt
+    double reach_x = dt * (n * std::fabs(vx) + std::fabs(ax) * dt * n * (n + 1.0) / 2.0);
+    double min_x = x - reach_x, max_x = x + reach_x;
+
+    min_x -= COAST_MARGIN; max_x += COAST_MARGIN;
+    min_y -= COAST_MARGIN; max_y += COAST_MARGIN;
+
+    if (min_y < WORLD_BOTTOM || min_x < WORLD_LEFT || max_x > WORLD_RIGHT) return false;
+
+    // The same reach as hull_might_touch, so no tick in between would have tested the hull
+    auto clear_of = [&](const SimBox& box)
+    {
+        double reach_box_x = LANDER_HULL_RADIUS + box.width / 2.0;
+        double reach_box_y = LANDER_HULL_RADIUS + box.height / 2.0;
+        return max_x <= box.position.x - reach_box_x || min_x >= box.position.x + reach_box_x ||
+               max_y <= box.position.y - reach_box_y || min_y >= box.position.y + reach_box_y;
+    };
+
+    for (int i = 0; i < PLATFORM_COUNT; i++) if (!clear_of(state.platforms[i])) return false;
+    for (int i = 0; i < ASTEROID_COUNT; i++) if (!clear_of(state.asteroids[i])) return false;
+    return true;
+}
+
+// Ticks of sim_step on a path path_is_clear has vouched for. Nothing can be touched, so
+// only the input and the integration run, tick by tick so the floats round as sim_step's.
+static void fly_clear(SimState& state, unsigned input, int ticks)
+{
+    for (int t = 0; t < ticks; t++) {
+        sim_apply_input(state, input);
+        integrate(state);
+    }
+    state.tick += ticks;
+}
+
+// How many of the next ticks (at most ticks) sim_step would accelerate and tilt the
+// lander exactly as it does on the first: all of them, unless the fuel runs out on the
+// way. Burns through the fuel tick by tick as sim_step does, then puts it back;
+// steady_acceleration is the acceleration on those ticks.
+static int steady_ticks(SimState& state, unsigned input, int ticks, glm::vec3& steady_acceleration)
+{
+    const glm::vec3 acceleration = state.acceleration;
+    const float fuel = state.fuel, rotation = state.rotation;
+
+    sim_apply_input(state, input);
+    steady_acceleration = state.acceleration;
+    const float steady_rotation = state.rotation;
+
+    // Without a burn, every tick is the same as the first
+    int steady = ticks;
+    if (state.fuel != fuel) {
+        steady = 1;
+        while (steady < ticks) {
+            sim_apply_input(state, input);
+            if (state.acceleration != steady_acceleration || state.rotation != steady_rotation) break;
+            steady++;
+        }
+    }
+
+    state.acceleration = acceleration;
+    state.fuel = fuel;
+    state.rotation = rotation;
+    return steady;
+}
+
+unsigned sim_step_held(SimState& state, unsigned input, unsigned ticks)
+{
+    unsigned stepped = 0;
+
+    while (stepped < ticks && !state.game_over)
+    {
+        // Grow the window while the whole of it stays clear. A burn only holds the
+        // acceleration steady until the fuel runs out, so no window reaches past that.
+        unsigned clear = 0;
+        unsigned window = std::min(COAST_MIN_TICKS, ticks - stepped);
+        glm::vec3 acceleration;
+        while ((unsigned)steady_ticks(state, input, (int)window, acceleration) == window &&
+               path_is_clear(state, acceleration, window)) {
+            clear = window;
+            if (window == ticks - stepped || window >= COAST_MAX_TICKS) break;
+            window = std::min(std::min(window * 2, COAST_MAX_TICKS), ticks - stepped);
+        }
+
+        // Nothing can happen on these ticks, so all sim_step would do is burn and integrate
+        if (clear > 0) {
+            fly_clear(state, input, (int)clear);
+            stepped += clear;
+        }
+
+        if (stepped < ticks) {
+            sim_step(state, input);
+            stepped++;
+        }
+    }
+
+    return stepped;
+}
+
+// ————— SWEPT STEPS ————— //
+// Slab test on one axis: the part of the move during which [low, high], moving by motion,
+// overlaps [other_low, other_high]
+static bool sweep_interval(float low, float high, float motion, float other_low, float other_high, float& enter, float& exit)
+{
+    if (motion == 0.0f) {
+        // Not moving on this axis: either overlapping the whole time or never
+        return other_low < high && low < other_high;
+    }
+
+    float t0 = (other_low - high) / motion;
+    float t1 = (other_high - low) / motion;
+    if (t0 > t1) std::swap(t0, t1);
+
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+    return true;
+}
+
+bool sim_sweep_collision(glm::vec3 start, glm::vec3 end, float width, float height, const SimBox& other, float& time)
+{
+    // Sweeping the centre point against the box grown by our half-size is the same as sweeping the box
+    float reach_x = (width + other.width) / 2.0f;
+    float reach_y = (height + other.height) / 2.0f;
+
+    // Most boxes are nowhere near the path, and this is cheaper than the slabs
+    if (std::min(start.x, end.x) - other.position.x >= reach_x || other.position.x - std::max(start.x, end.x) >= reach_x ||
+        std::min(start.y, end.y) - other.position.y >= reach_y || other.position.y - std::max(start.y, end.y) >= reach_y) {
+        return false;
+    }
+
+    float enter = 0.0f, exit = 1.0f;
+    if (!sweep_interval(start.x, start.x, end.x - start.x, other.position.x - reach_x, other.position.x + reach_x, enter, exit)) return false;
+    if (!sweep_interval(start.y, start.y, end.y - start.y, other.position.y - reach_y, other.position.y + reach_y, enter, exit)) return false;
+
+    // An empty or zero-length window is at most a touch
+    if (enter >= exit) return false;
+
+    time = enter;
+    return true;
+}
+
+void sim_step_swept(SimState& state, unsigned input, int ticks)
+{
+    if (ticks > 0) sim_step_held(state, input, (unsigned)ticks);
+}
+
+// ————— ADAPTIVE STEPS ————— //
+void sim_step_adaptive(SimState& state, unsigned input, int ticks, SimSubstepCounters& counters)
+{
+    if (state.game_over) return;
+
+    if (ticks <= 1) {
+        sim_step(state, input);
+        counters.fine_ticks++;
+        return;
+    }
+
+    // One bound can't cover the tick where the fuel runs out and the acceleration changes
+    glm::vec3 acceleration;
+    int steady = steady_ticks(state, input, ticks, acceleration);
+    if (steady < ticks) {
+        sim_step_adaptive(state, input, steady, counters);
+        sim_step_adaptive(state, input, ticks - steady, counters);
+        return;
+    }
+
+    if (path_is_clear(state, acceleration, (unsigned)ticks)) {
+        // Nothing to collide with on the way, so the whole step skips the collision tests
+        fly_clear(state, input, ticks);
+        counters.coarse_steps++;
+        counters.coarse_ticks += ticks;
+        return;
+    }
+
+    // Something is near: try the step as two halves
+    counters.splits++;
+
+    int first_half = ticks / 2;
+    sim_step_adaptive(state, input, first_half, counters);
+    sim_step_adaptive(state, input, ticks - first_half, counters);
+}
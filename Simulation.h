@@ -0,0 +1,207 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// Headless lander simulation. Everything the game needs to advance a tick lives
+// in SimState, so this file (and Simulation.cpp) must never include SDL or GL.
+#include "glm/glm.hpp"
+#include "Random.h"
+#include "Integrator.h"
+#include "Contact.h"
+#include <cstring>
+#include <type_traits>
+
+enum GameStatus { RUNNING, MISSION_FAILED, MISSION_ACCOMPLISHED };
+
+// Per-tick control state, one bit per control the player can hold down
+enum LanderInput
+{
+    INPUT_NONE   = 0,
+    INPUT_LEFT   = 1 << 0,
+    INPUT_RIGHT  = 1 << 1,
+    INPUT_THRUST = 1 << 2
+};
+
+// ————— GAME CONSTANTS ————— //
+constexpr float GRAVITY = -0.05f;
+constexpr float ACCELERATION_X = 0.90f; // Horizontal acceleration
+constexpr float ACCELERATION_Y = 0.95f; // Vertical acceleration (thrust)
+constexpr float HORIZONTAL_DAMPING = 0.995f;
+constexpr float MAX_FUEL = 100.0f;
+constexpr float FUEL_CONSUMPTION_RATE = 0.25f;
+constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+constexpr float LANDER_TILT = 15.0f; // Degrees the lander leans while thrusting sideways
+constexpr float LANDER_TILT_COS = 0.9659258262890683f,
+                LANDER_TILT_SIN = 0.2588190451025207f;
+
+// How the lander is integrated each FIXED_TIMESTEP: semi-implicit Euler, with
+// HORIZONTAL_DAMPING on x only. Constants, so they're ready before any static
+// initializer runs; the drag on x is -ln(HORIZONTAL_DAMPING) / FIXED_TIMESTEP.
+constexpr AxisStep LANDER_STEP_X = axis_step_with_drag(FIXED_TIMESTEP, HORIZONTAL_DAMPING, 0.300752193f),
+                   LANDER_STEP_Y = axis_step_with_drag(FIXED_TIMESTEP, 1.0f, 0.0f);
+
+constexpr int PLATFORM_COUNT = 10;
+constexpr int ASTEROID_COUNT = 3;
+constexpr int LANDING_ZONE = 0; // Index of the platform the lander has to land on
+
+// Body numbers in the lander's contacts: the lander, then the platforms and asteroids in order
+constexpr int BODY_LANDER   = 0,
+              BODY_PLATFORM = 1,
+              BODY_ASTEROID = BODY_PLATFORM + PLATFORM_COUNT;
+
+constexpr float LANDER_START_X = 0.0f,
+                LANDER_START_Y = 3.0f,
+                LANDER_WIDTH   = 1.0f,  // Bounding box of the upright hull (LanderHull.h)
+                LANDER_HEIGHT  = 1.0f;
+
+constexpr float PLATFORM_WIDTH  = 0.5f,
+                PLATFORM_HEIGHT = 0.2f,
+                ASTEROID_SIZE   = 0.3f;
+
+// Safe touchdown speeds on the landing zone
+constexpr float LANDING_MAX_SPEED_X = 0.3f,
+                LANDING_MAX_SPEED_Y = 0.5f;
+
+// Leaving the screen through the sides or the bottom loses the lander
+constexpr float WORLD_LEFT   = -5.0f,
+                WORLD_RIGHT  = 5.0f,
+                WORLD_BOTTOM = -3.75f;
+
+// Axis-aligned box, centred on position
+struct SimBox
+{
+    glm::vec3 position;
+    float     width,
+              height;
+};
+
+struct SimState
+{
+    // ————— LANDER ————— //
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec3 acceleration;
+    float     fuel;
+    float     rotation; // Degrees, 0 = pointing up
+
+    // ————— RULES ————— //
+    GameStatus status;
+    bool       game_over;
+    unsigned   tick;
+
+    // ————— CLOCK AND RANDOMNESS ————— //
+    float    time_accumulator; // Frame time not yet consumed by a FIXED_TIMESTEP
+    unsigned rng_key[2];       // Philox key: seed and episode id
+    unsigned rng_counter;      // Next Philox block to draw
+
+    // ————— LEVEL ————— //
+    SimBox platforms[PLATFORM_COUNT];
+    SimBox asteroids[ASTEROID_COUNT];
+};
+
+// Lays out the level and puts the lander at the start. Asteroid i is placed from
+// Philox block i under the key (seed, episode), so the layout depends on nothing else.
+void sim_init(SimState& state, unsigned seed, unsigned episode = 0);
+
+// Draws the next Philox block from the state's stream
+void sim_random(SimState& state, unsigned out[4]);
+
+// Where an asteroid lands for a pair of random words: x in [-4, 4], y in [-1, 2]
+inline float asteroid_x_from(unsigned bits) { return -4.0f + random_unit(bits) * 8.0f; }
+inline float asteroid_y_from(unsigned bits) { return random_unit(bits) * 3.0f - 1.0f; }
+
+// The platform row along the bottom of the screen, the same in every level: platform i
+// is centred at (platform_x(i), PLATFORM_Y)
+constexpr float PLATFORM_Y = -3.5f;
+constexpr float platform_x(int i) { return -4.75f + (i * 1.0f); }
+
+void sim_place_platforms(SimBox platforms[PLATFORM_COUNT]);
+
+// Puts the lander back at the start with a full tank, keeping the level layout
+void sim_reset(SimState& state);
+
+// Turns the held controls into acceleration, fuel burn and tilt for the next tick
+void sim_apply_input(SimState& state, unsigned input);
+
+// Advances one FIXED_TIMESTEP: input, integration, collisions and win/loss rules
+void sim_step(SimState& state, unsigned input);
+
+// The same, also adding the tick's contacts to contacts (which isn't cleared first).
+// The rules above are decided from exactly these contacts.
+void sim_step(SimState& state, unsigned input, ContactList& contacts);
+
+bool sim_check_collision(glm::vec3 position, float width, float height, const SimBox& other);
+
+// cos and sin of a rotation in degrees. The tilts sim_apply_input sets come from
+// the constants above, so every build agrees on them to the bit.
+void sim_hull_rotation(float rotation, float& cos_rotation, float& sin_rotation);
+
+// Whether the lander's hull, at position and rotated as draw_lander draws it, overlaps other.
+// This is the test sim_step uses for platforms and asteroids.
+bool sim_check_hull_collision(glm::vec3 position, float rotation, const SimBox& other);
+
+// ————— HELD INPUT ————— //
+// Coasting windows for sim_step_held(): the shortest worth bounding, the longest
+// bounded at once, and how far (in world units) path bounds are widened for rounding
+constexpr unsigned COAST_MIN_TICKS = 8,
+                   COAST_MAX_TICKS = 1024;
+constexpr double   COAST_MARGIN    = 0.01;
+
+// The same as calling sim_step ticks times with input held, bit for bit, stopping at
+// game over; returns how many ticks were stepped. On ticks where the lander provably
+// can't reach a box or leave the world, the collision tests are skipped and only the
+// burn and the integration run.
+unsigned sim_step_held(SimState& state, unsigned input, unsigned ticks);
+
+// ————— SWEPT STEPS ————— //
+// Where along the move from start to end a box of the given size first overlaps
+// other, as a fraction in [0, 1]. False if it never does. Overlap means the same
+// as in sim_check_collision, so boxes that only touch don't count.
+bool sim_sweep_collision(glm::vec3 start, glm::vec3 end, float width, float height, const SimBox& other, float& time);
+
+// Advances ticks FIXED_TIMESTEPs with input held throughout, as one coarse step of an
+// evaluation run. It's sim_step_held underneath, so the result is bit for bit that of
+// ticks sim_steps: a coarse step can't tunnel through a platform, and a run ends on
+// the same tick, with the same outcome and fuel, as it would tick by tick. The speed
+// comes from the stretches of the path that provably touch nothing, which skip the
+// collision tests. state.tick still counts FIXED_TIMESTEPs.
+void sim_step_swept(SimState& state, unsigned input, int ticks);
+
+// ————— ADAPTIVE STEPS ————— //
+// How sim_step_adaptive() spent an episode's ticks
+struct SimSubstepCounters
+{
+    unsigned coarse_steps; // Steps taken whole, without collision tests
+    unsigned coarse_ticks; // FIXED_TIMESTEPs those covered
+    unsigned splits;       // Steps that came near something and were halved
+    unsigned fine_ticks;   // Ticks that ended up as single sim_steps
+};
+
+// Advances ticks FIXED_TIMESTEPs with input held, bit for bit as that many sim_steps
+// would. A step whose whole path provably stays clear of every box and inside the
+// world skips the collision tests; otherwise it's halved, down to single sim_steps
+// near a collider, so contacts and the touchdown speed on the landing zone are judged
+// from the very state sim_step would judge them from. A step is also split where the
+// fuel runs out. counters is added to, not reset.
+void sim_step_adaptive(SimState& state, unsigned input, int ticks, SimSubstepCounters& counters);
+
+// ————— SNAPSHOTS ————— //
+// SimState holds the whole game, so a snapshot is a straight copy of its bytes.
+// Keep it that way: no pointers, no containers, nothing with a destructor.
+static_assert(std::is_trivially_copyable<SimState>::value, "SimState must stay a plain blob for snapshots");
+
+struct SimSnapshot
+{
+    alignas(SimState) unsigned char data[sizeof(SimState)];
+};
+
+inline void sim_save(const SimState& state, SimSnapshot& snapshot)
+{
+    std::memcpy(snapshot.data, &state, sizeof(SimState));
+}
+
+inline void sim_restore(SimState& state, const SimSnapshot& snapshot)
+{
+    std::memcpy(&state, snapshot.data, sizeof(SimState));
+}
+
+#endif // SIMULATION_H
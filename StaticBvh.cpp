@@ -0,0 +1,282 @@
+#include "StaticBvh.h"
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Node bounds are padded by a few ulps so rounding can never prune a node holding
+    // a box that the exact tests below would call a hit
+    float slack(float center, float size) { return (std::fabs(center) + size) * 1e-6f; }
+
+    // The same test as sim_check_collision
+    bool boxes_overlap(glm::vec3 position, float width, float height, const glm::vec4& box)
+    {
+        float x_distance = std::fabs(position.x - box.x) - ((width + box.z) / 2.0f);
+        float y_distance = std::fabs(position.y - box.y) - ((height + box.w) / 2.0f);
+
+        return x_distance < 0.0f && y_distance < 0.0f;
+    }
+
+    // Slab test on one axis: the part of the ray inside [low, high]
+    bool ray_slab(float origin, float direction, float low, float high, float& enter, float& exit)
+    {
+        if (direction == 0.0f) return low <= origin && origin <= high;
+
+        float t0 = (low - origin) / direction;
+        float t1 = (high - origin) / direction;
+        if (t0 > t1) std::swap(t0, t1);
+
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        return true;
+    }
+
+    // When the ray first enters the rectangle, if it does before max_time
+    bool ray_rectangle(glm::vec3 origin, glm::vec3 direction, float min_x, float min_y, float max_x, float max_y,
+                       float max_time, float& time)
+    {
+        float enter = 0.0f, exit = max_time;
+        if (!ray_slab(origin.x, direction.x, min_x, max_x, enter, exit)) return false;
+        if (!ray_slab(origin.y, direction.y, min_y, max_y, enter, exit)) return false;
+        if (enter > exit) return false;
+
+        time = enter;
+        return true;
+    }
+
+    bool is_better(float time, int index, const BvhHit& best)
+    {
+        return time < best.time || (time == best.time && index < best.index);
+    }
+}
+
+void StaticBvh::add(glm::vec3 position, float width, float height)
+{
+    m_boxes.push_back(glm::vec4(position.x, position.y, width, height));
+}
+
+void StaticBvh::clear()
+{
+    m_nodes.clear();
+    m_boxes.clear();
+    m_ids.clear();
+}
+
+void StaticBvh::build()
+{
+    m_nodes.clear();
+    m_ids.resize(m_boxes.size());
+    for (size_t i = 0; i < m_ids.size(); i++) m_ids[i] = (int)i;
+
+    if (m_boxes.empty()) return;
+
+    // split_node() orders m_ids; the boxes are put in that order once it's done
+    m_nodes.push_back(Node());
+    split_node(0, 0, (int)m_boxes.size());
+
+    std::vector<glm::vec4> leaf_order(m_boxes.size());
+    for (size_t i = 0; i < m_ids.size(); i++) leaf_order[i] = m_boxes[m_ids[i]];
+    m_boxes.swap(leaf_order);
+}
+
+void StaticBvh::split_node(int index, int first, int count)
+{
+    Node node;
+    float center_min_x = 0.0f, center_min_y = 0.0f, center_max_x = 0.0f, center_max_y = 0.0f;
+
+    for (int i = first; i < first + count; i++)
+    {
+        const glm::vec4& box = m_boxes[m_ids[i]];
+        float pad_x = slack(box.x, box.z), pad_y = slack(box.y, box.w);
+        float left = box.x - box.z / 2.0f - pad_x, right = box.x + box.z / 2.0f + pad_x;
+        float bottom = box.y - box.w / 2.0f - pad_y, top = box.y + box.w / 2.0f + pad_y;
+
+        bool first_box = i == first;
+        node.min_x = first_box ? left : std::min(node.min_x, left);
+        node.max_x = first_box ? right : std::max(node.max_x, right);
+        node.min_y = first_box ? bottom : std::min(node.min_y, bottom);
+        node.max_y = first_box ? top : std::max(node.max_y, top);
+
+        center_min_x = first_box ? box.x : std::min(center_min_x, box.x);
+        center_max_x = first_box ? box.x : std::max(center_max_x, box.x);
+        center_min_y = first_box ? box.y : std::min(center_min_y, box.y);
+        center_max_y = first_box ? box.y : std::max(center_max_y, box.y);
+    }
+
+    if (count <= LEAF_SIZE)
+    {
+        node.first = first;
+        node.count = count;
+        m_nodes[index] = node;
+        return;
+    }
+
+    // Halve the boxes across the longer spread of their centres
+    int axis = center_max_x - center_min_x >= center_max_y - center_min_y ? 0 : 1;
+    int half = count / 2;
+    std::nth_element(m_ids.begin() + first, m_ids.begin() + first + half, m_ids.begin() + first + count,
+                     [this, axis](int a, int b) { return m_boxes[a][axis] < m_boxes[b][axis]; });
+
+    // Both children go in together, so a node's right child is always its left child + 1
+    node.first = (int)m_nodes.size();
+    node.count = 0;
+    m_nodes[index] = node;
+    m_nodes.push_back(Node());
+    m_nodes.push_back(Node());
+
+    split_node(node.first, first, half);
+    split_node(node.first + 1, first + half, count - half);
+}
+
+// ————— QUERIES ————— //
+void StaticBvh::query_box(glm::vec3 position, float width, float height, std::vector<int>& hits) const
+{
+    hits.clear();
+    if (m_nodes.empty()) return;
+
+    float reach_x = width / 2.0f + slack(position.x, width);
+    float reach_y = height / 2.0f + slack(position.y, height);
+    float min_x = position.x - reach_x, max_x = position.x + reach_x;
+    float min_y = position.y - reach_y, max_y = position.y + reach_y;
+
+    // Median splits keep the tree about log2(count / LEAF_SIZE) deep, far below the stack size
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = m_nodes[stack[--top]];
+        if (min_x > node.max_x || max_x < node.min_x || min_y > node.max_y || max_y < node.min_y) continue;
+
+        if (node.count == 0) {
+            stack[top++] = node.first;
+            stack[top++] = node.first + 1;
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; i++) {
+            if (boxes_overlap(position, width, height, m_boxes[i])) hits.push_back(m_ids[i]);
+        }
+    }
+
+    std::sort(hits.begin(), hits.end());
+}
+
+void StaticBvh::query_point(glm::vec3 point, std::vector<int>& hits) const
+{
+    // A point is inside a box exactly when a zero-sized box there overlaps it
+    query_box(point, 0.0f, 0.0f, hits);
+}
+
+bool StaticBvh::raycast(glm::vec3 origin, glm::vec3 direction, float max_time, BvhHit& hit) const
+{
+    hit.index = -1;
+    hit.time = max_time;
+    if (m_nodes.empty()) return false;
+
+    // Nodes wait on the stack with the time the ray enters them; nearer children are
+    // popped first, and anything entered after the best hit so far is skipped
+    struct Entry { int node; float time; };
+    Entry stack[64];
+    int top = 0;
+
+    float time;
+    const Node& root = m_nodes[0];
+    if (!ray_rectangle(origin, direction, root.min_x, root.min_y, root.max_x, root.max_y, max_time, time)) return false;
+    stack[top++] = Entry{ 0, time };
+
+    while (top > 0)
+    {
+        Entry entry = stack[--top];
+        if (entry.time > hit.time) continue;
+        const Node& node = m_nodes[entry.node];
+
+        if (node.count == 0)
+        {
+            Entry children[2];
+            int reached = 0;
+            for (int c = 0; c < 2; c++) {
+                const Node& child = m_nodes[node.first + c];
+                if (ray_rectangle(origin, direction, child.min_x, child.min_y, child.max_x, child.max_y, hit.time, time)) {
+                    children[reached++] = Entry{ node.first + c, time };
+                }
+            }
+
+            if (reached == 2 && children[1].time > children[0].time) std::swap(children[0], children[1]);
+            for (int c = 0; c < reached; c++) stack[top++] = children[c];
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; i++)
+        {
+            const glm::vec4& box = m_boxes[i];
+            if (ray_rectangle(origin, direction, box.x - box.z / 2.0f, box.y - box.w / 2.0f,
+                              box.x + box.z / 2.0f, box.y + box.w / 2.0f, hit.time, time) &&
+                is_better(time, m_ids[i], hit)) {
+                hit.index = m_ids[i];
+                hit.time = time;
+            }
+        }
+    }
+
+    return hit.index >= 0;
+}
+
+bool StaticBvh::sweep(glm::vec3 start, glm::vec3 end, float width, float height, BvhHit& hit) const
+{
+    hit.index = -1;
+    hit.time = 1.0f;
+    if (m_nodes.empty()) return false;
+
+    // The centre's path against nodes grown by our half-size, as in sim_sweep_collision
+    glm::vec3 move = end - start;
+    float grow_x = width / 2.0f + slack(std::fabs(start.x) + std::fabs(end.x), width);
+    float grow_y = height / 2.0f + slack(std::fabs(start.y) + std::fabs(end.y), height);
+
+    struct Entry { int node; float time; };
+    Entry stack[64];
+    int top = 0;
+
+    float time;
+    const Node& root = m_nodes[0];
+    if (!ray_rectangle(start, move, root.min_x - grow_x, root.min_y - grow_y, root.max_x + grow_x, root.max_y + grow_y, 1.0f, time)) return false;
+    stack[top++] = Entry{ 0, time };
+
+    while (top > 0)
+    {
+        Entry entry = stack[--top];
+        if (entry.time > hit.time) continue;
+        const Node& node = m_nodes[entry.node];
+
+        if (node.count == 0)
+        {
+            Entry children[2];
+            int reached = 0;
+            for (int c = 0; c < 2; c++) {
+                const Node& child = m_nodes[node.first + c];
+                if (ray_rectangle(start, move, child.min_x - grow_x, child.min_y - grow_y,
+                                  child.max_x + grow_x, child.max_y + grow_y, hit.time, time)) {
+                    children[reached++] = Entry{ node.first + c, time };
+                }
+            }
+
+            if (reached == 2 && children[1].time > children[0].time) std::swap(children[0], children[1]);
+            for (int c = 0; c < reached; c++) stack[top++] = children[c];
+            continue;
+        }
+
+        for (int i = node.first; i < node.first + node.count; i++)
+        {
+            const glm::vec4& box = m_boxes[i];
+            SimBox other = { glm::vec3(box.x, box.y, 0.0f), box.z, box.w };
+            if (sim_sweep_collision(start, end, width, height, other, time) && is_better(time, m_ids[i], hit)) {
+                hit.index = m_ids[i];
+                hit.time = time;
+            }
+        }
+    }
+
+    return hit.index >= 0;
+}
@@ -0,0 +1,64 @@
+#ifndef STATIC_BVH_H
+#define STATIC_BVH_H
+
+// Bounding volume hierarchy over boxes that never move (platforms, asteroids),
+// built once when the level loads. Nodes live in one flat array, children of a
+// node side by side, and the boxes are copied into leaf order so a leaf's boxes
+// sit next to each other in memory.
+//
+// Queries give exact answers, not candidates: a box hit is decided exactly as
+// sim_check_collision decides it, and a swept box exactly as sim_sweep_collision.
+#include "glm/glm.hpp"
+#include <vector>
+
+// Nearest hit of a ray or swept box
+struct BvhHit
+{
+    int   index; // Box number, in the order they were added
+    float time;  // Along the ray, in lengths of its direction; along a sweep, as a fraction of the move
+};
+
+class StaticBvh
+{
+private:
+    struct Node
+    {
+        float min_x, min_y, max_x, max_y;
+        int   first; // Leaf: its first box; inner node: its left child, with the right one after it
+        int   count; // Boxes in a leaf, 0 for an inner node
+    };
+
+    static constexpr int LEAF_SIZE = 4;
+
+    std::vector<Node>      m_nodes;  // m_nodes[0] is the root
+    std::vector<glm::vec4> m_boxes;  // Centre x, centre y, width, height; in leaf order after build()
+    std::vector<int>       m_ids;    // Number of each entry of m_boxes
+
+    void split_node(int index, int first, int count);
+
+public:
+    // ————— METHODS ————— //
+    // Boxes are numbered in the order they're added
+    void add(glm::vec3 position, float width, float height);
+    void build();
+    void clear();
+
+    // Every box the query box overlaps, or the point is inside, in ascending order.
+    // Both clear hits first.
+    void query_box(glm::vec3 position, float width, float height, std::vector<int>& hits) const;
+    void query_point(glm::vec3 point, std::vector<int>& hits) const;
+
+    // First box the ray enters before max_time lengths of direction; a ray starting
+    // inside a box hits it at time 0. Ties go to the lower box number.
+    bool raycast(glm::vec3 origin, glm::vec3 direction, float max_time, BvhHit& hit) const;
+
+    // First box a box of the given size overlaps on its way from start to end,
+    // with ties going to the lower box number
+    bool sweep(glm::vec3 start, glm::vec3 end, float width, float height, BvhHit& hit) const;
+
+    // ————— GETTERS ————— //
+    int get_count() const { return (int)m_boxes.size(); }
+    int get_node_count() const { return (int)m_nodes.size(); }
+};
+
+#endif // STATIC_BVH_H
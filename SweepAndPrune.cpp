@@ -0,0 +1,114 @@
+#include "SweepAndPrune.h"
+#include <cmath>
+
+namespace
+{
+    // Intervals are padded by a few ulps so rounding can never sort apart two boxes
+    // that boxes_overlap() would call overlapping
+    float slack(const glm::vec4& box) { return (std::fabs(box.x) + box.z) * 1e-6f; }
+    float min_x(const glm::vec4& box) { return box.x - box.z / 2.0f - slack(box); }
+    float max_x(const glm::vec4& box) { return box.x + box.z / 2.0f + slack(box); }
+
+    // Min ends sort before max ends at the same x, so touching boxes still get compared
+    bool comes_before(float value, unsigned key, float other_value, unsigned other_key)
+    {
+        return value < other_value || (value == other_value && (key & 1u) < (other_key & 1u));
+    }
+
+    // The same test as Entity::check_collision and sim_check_collision
+    bool boxes_overlap(const glm::vec4& box, const glm::vec4& other)
+    {
+        float x_distance = std::fabs(box.x - other.x) - ((box.z + other.z) / 2.0f);
+        float y_distance = std::fabs(box.y - other.y) - ((box.w + other.w) / 2.0f);
+
+        return x_distance < 0.0f && y_distance < 0.0f;
+    }
+}
+
+int SweepAndPrune::add(glm::vec3 position, float width, float height, unsigned category, unsigned mask)
+{
+    int id = (int)m_boxes.size();
+    m_boxes.push_back(glm::vec4(position.x, position.y, width, height));
+    m_category.push_back(category);
+    m_mask.push_back(mask);
+    m_active_slot.push_back(-1);
+
+    // Appended at the end; the next sort moves them into place
+    m_endpoints.push_back(Endpoint{ min_x(m_boxes[id]), (unsigned)id << 1 });
+    m_endpoints.push_back(Endpoint{ max_x(m_boxes[id]), ((unsigned)id << 1) | 1u });
+    return id;
+}
+
+void SweepAndPrune::move(int id, glm::vec3 position, float width, float height)
+{
+    // Endpoint values are refreshed from the boxes when the list is next sorted
+    m_boxes[id] = glm::vec4(position.x, position.y, width, height);
+}
+
+void SweepAndPrune::clear()
+{
+    m_endpoints.clear();
+    m_boxes.clear();
+    m_category.clear();
+    m_mask.clear();
+    m_active.clear();
+    m_active_slot.clear();
+}
+
+void SweepAndPrune::sort_endpoints()
+{
+    for (Endpoint& endpoint : m_endpoints)
+    {
+        const glm::vec4& box = m_boxes[endpoint.key >> 1];
+        endpoint.value = endpoint.key & 1u ? max_x(box) : min_x(box);
+    }
+
+    // Insertion sort: last tick's order is nearly right, so each endpoint only moves a few places
+    for (size_t i = 1; i < m_endpoints.size(); i++)
+    {
+        Endpoint endpoint = m_endpoints[i];
+        size_t j = i;
+        while (j > 0 && comes_before(endpoint.value, endpoint.key, m_endpoints[j - 1].value, m_endpoints[j - 1].key))
+        {
+            m_endpoints[j] = m_endpoints[j - 1];
+            j--;
+        }
+        m_endpoints[j] = endpoint;
+    }
+}
+
+void SweepAndPrune::find_pairs(std::vector<OverlapPair>& pairs)
+{
+    pairs.clear();
+    sort_endpoints();
+
+    // Every box entering the sweep is tested against the boxes it's inside of on x
+    for (const Endpoint& endpoint : m_endpoints)
+    {
+        int id = (int)(endpoint.key >> 1);
+
+        if (endpoint.key & 1u)
+        {
+            // Leaving: swap the last active box into this one's slot
+            int slot = m_active_slot[id];
+            m_active[slot] = m_active.back();
+            m_active_slot[m_active[slot]] = slot;
+            m_active.pop_back();
+            m_active_slot[id] = -1;
+        }
+        else
+        {
+            const glm::vec4& box = m_boxes[id];
+            unsigned category = m_category[id], mask = m_mask[id];
+            for (int other : m_active)
+            {
+                if (layers_collide(category, mask, m_category[other], m_mask[other]) && boxes_overlap(box, m_boxes[other])) {
+                    pairs.push_back(id < other ? OverlapPair{ id, other } : OverlapPair{ other, id });
+                }
+            }
+
+            m_active_slot[id] = (int)m_active.size();
+            m_active.push_back(id);
+        }
+    }
+}
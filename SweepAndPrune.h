@@ -0,0 +1,51 @@
+#ifndef SWEEP_AND_PRUNE_H
+#define SWEEP_AND_PRUNE_H
+
+// Sweep-and-prune broadphase for boxes that move every tick. The min and max x of
+// every box are kept in one list that stays sorted between ticks; movers only shift
+// a little per tick, so re-sorting it with insertion sort is close to linear. A sweep
+// along that list then only compares boxes whose x intervals overlap.
+#include "glm/glm.hpp"
+#include "CollisionLayers.h"
+#include <vector>
+
+// Two boxes that overlap, with a < b
+struct OverlapPair
+{
+    int a, b;
+};
+
+class SweepAndPrune
+{
+private:
+    struct Endpoint
+    {
+        float    value;
+        unsigned key; // Box id << 1, low bit set for the max end
+    };
+
+    std::vector<Endpoint>  m_endpoints;
+    std::vector<glm::vec4> m_boxes;  // Centre x, centre y, width, height
+    std::vector<unsigned>  m_category, m_mask; // Collision layers of each box
+    std::vector<int>       m_active; // Boxes whose x interval the sweep is inside
+    std::vector<int>       m_active_slot;
+
+    void sort_endpoints();
+
+public:
+    // ————— METHODS ————— //
+    // Boxes are numbered in the order they're added. Pairs whose layers don't collide
+    // (CollisionLayers.h) are never reported, and never get as far as a box test.
+    int  add(glm::vec3 position, float width, float height, unsigned category = LAYER_ALL, unsigned mask = LAYER_ALL);
+    void move(int id, glm::vec3 position, float width, float height);
+    void clear();
+
+    // Writes every overlapping pair, as Entity::check_collision would judge it, into pairs
+    // (cleared first). Pairs come out in sweep order.
+    void find_pairs(std::vector<OverlapPair>& pairs);
+
+    // ————— GETTERS ————— //
+    int get_count() const { return (int)m_boxes.size(); }
+};
+
+#endif // SWEEP_AND_PRUNE_H
@@ -0,0 +1,173 @@
+#include "UniformGrid.h"
+#include <algorithm>
+#include <cmath>
+
+UniformGrid::UniformGrid(float cell_size)
+    : m_cell_size(cell_size), m_origin_x(0.0f), m_origin_y(0.0f), m_columns(1), m_rows(1), m_cell_start(2, 0)
+{
+}
+
+UniformGrid::CellRange UniformGrid::cell_range(glm::vec3 position, float width, float height) const
+{
+    auto cell = [this](float coordinate, float origin, int count)
+    {
+        int index = (int)std::floor((coordinate - origin) / m_cell_size);
+        return std::min(std::max(index, 0), count - 1);
+    };
+
+    CellRange range;
+    range.min_x = cell(position.x - width / 2.0f, m_origin_x, m_columns);
+    range.max_x = cell(position.x + width / 2.0f, m_origin_x, m_columns);
+    range.min_y = cell(position.y - height / 2.0f, m_origin_y, m_rows);
+    range.max_y = cell(position.y + height / 2.0f, m_origin_y, m_rows);
+    return range;
+}
+
+// ————— STATIC BOXES ————— //
+void UniformGrid::add_static(glm::vec3 position, float width, float height)
+{
+    m_static_boxes.push_back(glm::vec4(position.x, position.y, width, height));
+}
+
+void UniformGrid::build_static()
+{
+    // Fit the grid to everything static
+    float min_x = 0.0f, min_y = 0.0f, max_x = 0.0f, max_y = 0.0f;
+    for (size_t i = 0; i < m_static_boxes.size(); i++)
+    {
+        const glm::vec4& box = m_static_boxes[i];
+        float left = box.x - box.z / 2.0f, right = box.x + box.z / 2.0f;
+        float bottom = box.y - box.w / 2.0f, top = box.y + box.w / 2.0f;
+
+        min_x = i == 0 ? left : std::min(min_x, left);
+        max_x = i == 0 ? right : std::max(max_x, right);
+        min_y = i == 0 ? bottom : std::min(min_y, bottom);
+        max_y = i == 0 ? top : std::max(max_y, top);
+    }
+
+    m_origin_x = min_x;
+    m_origin_y = min_y;
+    m_columns = std::max(1, (int)std::floor((max_x - min_x) / m_cell_size) + 1);
+    m_rows = std::max(1, (int)std::floor((max_y - min_y) / m_cell_size) + 1);
+    const int cell_count = m_columns * m_rows;
+
+    m_static_ranges.resize(m_static_boxes.size());
+    for (size_t i = 0; i < m_static_boxes.size(); i++) {
+        const glm::vec4& box = m_static_boxes[i];
+        m_static_ranges[i] = cell_range(glm::vec3(box.x, box.y, 0.0f), box.z, box.w);
+    }
+
+    // Counting sort into one packed table: count per cell, prefix sum, then fill.
+    // Boxes go in by index, so every cell's list comes out ascending.
+    m_cell_start.assign(cell_count + 1, 0);
+    for (const CellRange& range : m_static_ranges)
+        for (int y = range.min_y; y <= range.max_y; y++)
+            for (int x = range.min_x; x <= range.max_x; x++) m_cell_start[y * m_columns + x + 1]++;
+
+    for (int c = 0; c < cell_count; c++) m_cell_start[c + 1] += m_cell_start[c];
+
+    std::vector<int> fill(m_cell_start.begin(), m_cell_start.end() - 1);
+    m_cell_items.resize(m_cell_start[cell_count]);
+    for (int i = 0; i < (int)m_static_ranges.size(); i++)
+    {
+        const CellRange& range = m_static_ranges[i];
+        for (int y = range.min_y; y <= range.max_y; y++)
+            for (int x = range.min_x; x <= range.max_x; x++) m_cell_items[fill[y * m_columns + x]++] = i;
+    }
+
+    m_mover_ranges.clear();
+    m_mover_cells.assign(cell_count, std::vector<int>());
+}
+
+// ————— MOVERS ————— //
+void UniformGrid::link_mover(int id)
+{
+    const CellRange& range = m_mover_ranges[id];
+    for (int y = range.min_y; y <= range.max_y; y++)
+        for (int x = range.min_x; x <= range.max_x; x++) m_mover_cells[y * m_columns + x].push_back(id);
+}
+
+void UniformGrid::unlink_mover(int id)
+{
+    const CellRange& range = m_mover_ranges[id];
+    for (int y = range.min_y; y <= range.max_y; y++)
+        for (int x = range.min_x; x <= range.max_x; x++)
+        {
+            // Order within a cell doesn't matter, so swap the last entry into the hole
+            std::vector<int>& cell = m_mover_cells[y * m_columns + x];
+            for (size_t k = 0; k < cell.size(); k++) {
+                if (cell[k] == id) {
+                    cell[k] = cell.back();
+                    cell.pop_back();
+                    break;
+                }
+            }
+        }
+}
+
+int UniformGrid::add_mover(glm::vec3 position, float width, float height)
+{
+    if (m_mover_cells.empty()) m_mover_cells.resize(m_columns * m_rows);
+
+    m_mover_ranges.push_back(cell_range(position, width, height));
+    int id = (int)m_mover_ranges.size() - 1;
+    link_mover(id);
+    return id;
+}
+
+void UniformGrid::move_mover(int id, glm::vec3 position, float width, float height)
+{
+    CellRange range = cell_range(position, width, height);
+    const CellRange& old = m_mover_ranges[id];
+
+    // Most ticks a mover stays inside the same cells, and then there's nothing to do
+    if (range.min_x == old.min_x && range.min_y == old.min_y && range.max_x == old.max_x && range.max_y == old.max_y) return;
+
+    unlink_mover(id);
+    m_mover_ranges[id] = range;
+    link_mover(id);
+}
+
+// ————— QUERIES ————— //
+void UniformGrid::query_static(glm::vec3 position, float width, float height, std::vector<int>& candidates) const
+{
+    candidates.clear();
+    CellRange query = cell_range(position, width, height);
+
+    for (int y = query.min_y; y <= query.max_y; y++)
+        for (int x = query.min_x; x <= query.max_x; x++)
+        {
+            int cell = y * m_columns + x;
+            for (int k = m_cell_start[cell]; k < m_cell_start[cell + 1]; k++)
+            {
+                // A box spanning several cells is only reported from the first cell it
+                // shares with the query, so no deduplication pass is needed
+                int i = m_cell_items[k];
+                const CellRange& range = m_static_ranges[i];
+                if (x == std::max(range.min_x, query.min_x) && y == std::max(range.min_y, query.min_y)) {
+                    candidates.push_back(i);
+                }
+            }
+        }
+
+    std::sort(candidates.begin(), candidates.end());
+}
+
+void UniformGrid::query_movers(glm::vec3 position, float width, float height, std::vector<int>& candidates) const
+{
+    candidates.clear();
+    if (m_mover_cells.empty()) return;
+    CellRange query = cell_range(position, width, height);
+
+    for (int y = query.min_y; y <= query.max_y; y++)
+        for (int x = query.min_x; x <= query.max_x; x++)
+            for (int id : m_mover_cells[y * m_columns + x])
+            {
+                const CellRange& range = m_mover_ranges[id];
+                if (x == std::max(range.min_x, query.min_x) && y == std::max(range.min_y, query.min_y)) {
+                    candidates.push_back(id);
+                }
+            }
+
+    std::sort(candidates.begin(), candidates.end());
+}
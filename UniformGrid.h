@@ -0,0 +1,68 @@
+#ifndef UNIFORM_GRID_H
+#define UNIFORM_GRID_H
+
+// Uniform-grid broadphase over axis-aligned boxes (centre position plus width and
+// height, like SimBox and Entity). Static boxes are binned once into a packed
+// cell table; movers live in per-cell lists that are only touched when a mover
+// crosses into different cells. Queries return the index of every box whose cells
+// meet the query box's cells, so the narrowphase only runs against those.
+//
+// The grid covers the bounds of the static boxes. Anything outside them is
+// clamped into the border cells, which keeps queries correct, just less selective.
+#include "glm/glm.hpp"
+#include <vector>
+
+class UniformGrid
+{
+private:
+    // Inclusive range of cells a box covers
+    struct CellRange
+    {
+        int min_x, min_y,
+            max_x, max_y;
+    };
+
+    float m_cell_size;
+    float m_origin_x, m_origin_y;
+    int   m_columns, m_rows;
+
+    // ————— STATIC BOXES ————— //
+    std::vector<glm::vec4> m_static_boxes;  // Centre x, centre y, width, height, until build_static()
+    std::vector<CellRange> m_static_ranges;
+    std::vector<int>       m_cell_start;    // Cell c holds m_cell_items[m_cell_start[c] .. m_cell_start[c + 1])
+    std::vector<int>       m_cell_items;
+
+    // ————— MOVERS ————— //
+    std::vector<CellRange>        m_mover_ranges;
+    std::vector<std::vector<int>> m_mover_cells;
+
+    CellRange cell_range(glm::vec3 position, float width, float height) const;
+    void link_mover(int id);
+    void unlink_mover(int id);
+
+public:
+    // ————— METHODS ————— //
+    explicit UniformGrid(float cell_size);
+
+    // Static boxes are numbered in the order they're added, so add them in the same
+    // order as the array the query results will index into
+    void add_static(glm::vec3 position, float width, float height);
+    void build_static(); // Fits the grid to the static boxes and bins them; drops any movers
+
+    // Movers are numbered in the order they're added
+    int  add_mover(glm::vec3 position, float width, float height);
+    void move_mover(int id, glm::vec3 position, float width, float height);
+
+    // Candidates near the box, each once and in ascending order. Both clear the output first.
+    void query_static(glm::vec3 position, float width, float height, std::vector<int>& candidates) const;
+    void query_movers(glm::vec3 position, float width, float height, std::vector<int>& candidates) const;
+
+    // ————— GETTERS ————— //
+    float get_cell_size() const { return m_cell_size; }
+    int get_columns() const { return m_columns; }
+    int get_rows() const { return m_rows; }
+    int get_static_count() const { return (int)m_static_ranges.size(); }
+    int get_mover_count() const { return (int)m_mover_ranges.size(); }
+};
+
+#endif // UNIFORM_GRID_H
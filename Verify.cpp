@@ -0,0 +1,261 @@
+#include "Verify.h"
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+constexpr std::uint64_t FNV_PRIME = 0x100000001B3ull;
+
+namespace
+{
+    std::uint64_t fold(std::uint64_t hash, std::uint32_t word)
+    {
+        for (int b = 0; b < 4; b++) {
+            hash ^= (word >> (b * 8)) & 0xFFu;
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+
+    std::uint32_t float_bits(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    // Saved traces sit next to each other under the replay's file name
+    std::string trace_path(const std::string& directory, const std::string& replay, bool fixed_point)
+    {
+        std::size_t slash = replay.find_last_of("/\\");
+        std::string name = slash == std::string::npos ? replay : replay.substr(slash + 1);
+        return directory + "/" + name + (fixed_point ? ".fixed.trace" : ".trace");
+    }
+}
+
+std::uint64_t hash_tick(std::uint64_t previous, float position_x, float position_y,
+                        float velocity_x, float velocity_y, float fuel, int status)
+{
+    std::uint64_t hash = previous;
+    hash = fold(hash, float_bits(position_x));
+    hash = fold(hash, float_bits(position_y));
+    hash = fold(hash, float_bits(velocity_x));
+    hash = fold(hash, float_bits(velocity_y));
+    hash = fold(hash, float_bits(fuel));
+    hash = fold(hash, (std::uint32_t)status);
+    return hash;
+}
+
+std::uint64_t hash_tick(std::uint64_t previous, const FixedSimState& state)
+{
+    std::uint64_t hash = previous;
+    hash = fold(hash, (std::uint32_t)state.position_x.raw);
+    hash = fold(hash, (std::uint32_t)state.position_y.raw);
+    hash = fold(hash, (std::uint32_t)state.velocity_x.raw);
+    hash = fold(hash, (std::uint32_t)state.velocity_y.raw);
+    hash = fold(hash, (std::uint32_t)state.fuel.raw);
+    hash = fold(hash, (std::uint32_t)state.status);
+    return hash;
+}
+
+// ————— TRACES ————— //
+std::vector<std::uint64_t> trace_scalar(const ReplayHeader& header, const std::uint32_t* runs)
+{
+    std::vector<std::uint64_t> trace;
+    trace.reserve(header.tick_count);
+
+    SimState state;
+    sim_init(state, header.seed, header.episode);
+
+    ReplayCursor cursor(runs, header.run_count);
+    std::uint64_t hash = STATE_HASH_SEED;
+    for (std::uint32_t t = 0; t < header.tick_count; t++) {
+        sim_step(state, cursor.next());
+        hash = hash_tick(hash, state);
+        trace.push_back(hash);
+    }
+    return trace;
+}
+
+std::vector<std::uint64_t> trace_batch(const ReplayHeader& header, const std::uint32_t* runs)
+{
+    std::vector<std::uint64_t> trace;
+    trace.reserve(header.tick_count);
+
+    // One live lane; the rest of the register is padding that never runs
+    LanderBatch batch(1);
+    batch.init(header.seed, header.episode);
+
+    ReplayCursor cursor(runs, header.run_count);
+    std::uint64_t hash = STATE_HASH_SEED;
+    for (std::uint32_t t = 0; t < header.tick_count; t++) {
+        unsigned char input = (unsigned char)cursor.next();
+        batch.step(&input);
+        hash = hash_tick(hash, batch.get_position_x()[0], batch.get_position_y()[0],
+                         batch.get_velocity_x()[0], batch.get_velocity_y()[0],
+                         batch.get_fuel()[0], batch.get_status()[0]);
+        trace.push_back(hash);
+    }
+    return trace;
+}
+
+std::vector<std::uint64_t> trace_fixed(const ReplayHeader& header, const std::uint32_t* runs)
+{
+    std::vector<std::uint64_t> trace;
+    trace.reserve(header.tick_count);
+
+    FixedSimState state;
+    fixed_sim_init(state, header.seed, header.episode);
+
+    ReplayCursor cursor(runs, header.run_count);
+    std::uint64_t hash = STATE_HASH_SEED;
+    for (std::uint32_t t = 0; t < header.tick_count; t++) {
+        fixed_sim_step(state, cursor.next());
+        hash = hash_tick(hash, state);
+        trace.push_back(hash);
+    }
+    return trace;
+}
+
+long long first_divergence(const std::vector<std::uint64_t>& expected, const std::vector<std::uint64_t>& actual)
+{
+    std::size_t common = expected.size() < actual.size() ? expected.size() : actual.size();
+    for (std::size_t t = 0; t < common; t++) {
+        if (expected[t] != actual[t]) return (long long)t;
+    }
+    return expected.size() == actual.size() ? -1 : (long long)common;
+}
+
+bool save_trace(const std::string& path, const std::vector<std::uint64_t>& trace)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    std::uint64_t count = trace.size();
+    file.write((const char*)&count, sizeof(count));
+    file.write((const char*)trace.data(), trace.size() * sizeof(std::uint64_t));
+    return (bool)file;
+}
+
+bool load_trace(const std::string& path, std::vector<std::uint64_t>& trace)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    std::uint64_t count = 0;
+    if (!file.read((char*)&count, sizeof(count))) return false;
+
+    trace.resize((std::size_t)count);
+    file.read((char*)trace.data(), trace.size() * sizeof(std::uint64_t));
+    return (bool)file;
+}
+
+// ————— SWEPT STEPS ————— //
+long long swept_divergence(const ReplayHeader& header, const std::uint32_t* runs, int ticks_per_step,
+                           std::uint64_t& expected, std::uint64_t& actual)
+{
+    SimState stepped, swept;
+    sim_init(stepped, header.seed, header.episode);
+    sim_init(swept, header.seed, header.episode);
+
+    ReplayCursor cursor(runs, header.run_count);
+    for (std::uint32_t t = 0; t < header.tick_count && !stepped.game_over; t += ticks_per_step) {
+        unsigned input = cursor.next();
+        for (int k = 1; k < ticks_per_step; k++) cursor.next();
+
+        for (int k = 0; k < ticks_per_step && !stepped.game_over; k++) sim_step(stepped, input);
+        sim_step_swept(swept, input, ticks_per_step);
+
+        expected = hash_tick(STATE_HASH_SEED, stepped);
+        actual = hash_tick(STATE_HASH_SEED, swept);
+        if (expected != actual) return (long long)t;
+    }
+    return -1;
+}
+
+// ————— VERIFIER ————— //
+namespace
+{
+    VerifyResult verify_one(const std::string& replay, VerifyMode mode, const std::string& trace_directory,
+                            bool fixed_point, int ticks_per_step)
+    {
+        VerifyResult result;
+        result.replay = replay;
+        result.loaded = false;
+        result.tick_count = 0;
+        result.divergence = -1;
+        result.expected = result.actual = 0;
+
+        ReplayFile file;
+        if (!file.open(replay)) return result;
+        result.tick_count = file.get_header().tick_count;
+
+        // Swept steps are checked against ticks in the same run, not against a trace
+        if (mode == VERIFY_SWEPT_VS_STEPPED) {
+            result.loaded = true;
+            result.divergence = swept_divergence(file.get_header(), file.get_runs(), ticks_per_step,
+                                                 result.expected, result.actual);
+            return result;
+        }
+
+        std::vector<std::uint64_t> expected;
+        std::vector<std::uint64_t> actual = fixed_point && mode != VERIFY_SCALAR_VS_BATCH
+                                          ? trace_fixed(file.get_header(), file.get_runs())
+                                          : trace_scalar(file.get_header(), file.get_runs());
+
+        switch (mode)
+        {
+            case VERIFY_SCALAR_VS_BATCH:
+                expected.swap(actual);
+                actual = trace_batch(file.get_header(), file.get_runs());
+                break;
+
+            case VERIFY_SAVE_TRACES:
+                result.loaded = save_trace(trace_path(trace_directory, replay, fixed_point), actual);
+                return result;
+
+            case VERIFY_CHECK_TRACES:
+                if (!load_trace(trace_path(trace_directory, replay, fixed_point), expected)) return result;
+                break;
+
+            case VERIFY_SWEPT_VS_STEPPED:
+                break;
+        }
+
+        result.loaded = true;
+        result.divergence = first_divergence(expected, actual);
+        if (result.divergence >= 0) {
+            std::size_t t = (std::size_t)result.divergence;
+            result.expected = t < expected.size() ? expected[t] : 0;
+            result.actual = t < actual.size() ? actual[t] : 0;
+        }
+        return result;
+    }
+}
+
+std::vector<VerifyResult> verify_replays(const std::vector<std::string>& replays, VerifyMode mode,
+                                         const std::string& trace_directory, int worker_count,
+                                         bool fixed_point, int ticks_per_step)
+{
+    std::vector<VerifyResult> results(replays.size());
+
+    if (worker_count <= 0) worker_count = (int)std::thread::hardware_concurrency();
+    if ((std::size_t)worker_count > replays.size()) worker_count = (int)replays.size();
+    if (worker_count < 1) worker_count = 1;
+
+    // Replays are few and long, so workers just take the next one off a shared counter
+    std::atomic<std::size_t> next(0);
+    auto work = [&]()
+    {
+        for (std::size_t i = next++; i < replays.size(); i = next++) {
+            results[i] = verify_one(replays[i], mode, trace_directory, fixed_point, ticks_per_step);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < worker_count; w++) workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers) worker.join();
+
+    return results;
+}
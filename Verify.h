@@ -0,0 +1,81 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+// Determinism checks. Every tick of a replay is folded into a running 64-bit hash
+// of the lander (position, velocity, fuel, status), giving one hash per tick. Two
+// runs of the same replay agree exactly when their traces do, and the first
+// differing entry is the first tick where they went apart.
+#include "Replay.h"
+#include "LanderBatch.h"
+#include "FixedSim.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr std::uint64_t STATE_HASH_SEED = 0xCBF29CE484222325ull; // FNV-1a offset basis
+
+// Folds one tick's lander state into the running hash (FNV-1a over the raw float bits)
+std::uint64_t hash_tick(std::uint64_t previous, float position_x, float position_y,
+                        float velocity_x, float velocity_y, float fuel, int status);
+
+inline std::uint64_t hash_tick(std::uint64_t previous, const SimState& state)
+{
+    return hash_tick(previous, state.position.x, state.position.y,
+                     state.velocity.x, state.velocity.y, state.fuel, state.status);
+}
+
+// The same fields of the fixed-point lander, folded as their raw Q16.16 ints
+std::uint64_t hash_tick(std::uint64_t previous, const FixedSimState& state);
+
+// ————— TRACES ————— //
+// Hash after every tick of the replay, through sim_step or through a LanderBatch lane
+std::vector<std::uint64_t> trace_scalar(const ReplayHeader& header, const std::uint32_t* runs);
+std::vector<std::uint64_t> trace_batch(const ReplayHeader& header, const std::uint32_t* runs);
+
+// Hash after every tick of the replay through fixed_sim_step, which is the same on
+// every build and machine
+std::vector<std::uint64_t> trace_fixed(const ReplayHeader& header, const std::uint32_t* runs);
+
+// Index of the first tick where the traces differ (a shorter trace differs where it
+// ends), or -1 if they match
+long long first_divergence(const std::vector<std::uint64_t>& expected, const std::vector<std::uint64_t>& actual);
+
+bool save_trace(const std::string& path, const std::vector<std::uint64_t>& trace);
+bool load_trace(const std::string& path, std::vector<std::uint64_t>& trace);
+
+// ————— SWEPT STEPS ————— //
+// Plays the replay with the input at the start of every ticks_per_step ticks held for
+// all of them, once through sim_step tick by tick and once through sim_step_swept.
+// Returns the first tick after which the two landers' state hashes differ, or -1 if
+// they never do; expected and actual are then the two hashes.
+long long swept_divergence(const ReplayHeader& header, const std::uint32_t* runs, int ticks_per_step,
+                           std::uint64_t& expected, std::uint64_t& actual);
+
+// ————— VERIFIER ————— //
+enum VerifyMode
+{
+    VERIFY_SCALAR_VS_BATCH, // Same build, both stepping paths
+    VERIFY_SAVE_TRACES,     // Write this build's scalar traces for another build to check
+    VERIFY_CHECK_TRACES,    // Compare this build's scalar traces against saved ones
+    VERIFY_SWEPT_VS_STEPPED // Same build, sim_step_swept against sim_step with actions held
+};
+
+struct VerifyResult
+{
+    std::string   replay;
+    bool          loaded;     // False if the replay (or its saved trace) couldn't be read
+    std::uint32_t tick_count;
+    long long     divergence; // First differing tick, -1 if none
+    std::uint64_t expected,
+                  actual;     // Hashes at the divergence
+};
+
+// Checks every replay, spread over worker_count threads (0 = one per hardware thread).
+// trace_directory is where VERIFY_SAVE_TRACES writes and VERIFY_CHECK_TRACES reads.
+// With fixed_point, those two modes trace the fixed-point simulation instead of sim_step,
+// under their own file names. VERIFY_SWEPT_VS_STEPPED holds actions ticks_per_step ticks.
+std::vector<VerifyResult> verify_replays(const std::vector<std::string>& replays, VerifyMode mode,
+                                         const std::string& trace_directory, int worker_count,
+                                         bool fixed_point = false, int ticks_per_step = 1);
+
+#endif // VERIFY_H
@@ -0,0 +1,985 @@
+// Benchmarks for the simulation and rendering hot paths. Every result is printed as
+// one JSON object per line (JSON Lines) on stdout, so runs can be diffed or loaded
+// straight into a script:
+//
+//   {"benchmark":"check_collision","entities":1024,"iterations":...,"ns_per_op":...,"ops_per_sec":...}
+//
+// The render pass runs under a software GL driver by default so results don't
+// depend on the GPU: Mesa's llvmpipe is requested through its environment
+// variables, and on Windows it is picked up from a Mesa opengl32.dll placed next to
+// the executable. The driver that was actually used is reported as "renderer".
+//
+// Where Linux perf counters can be read, the collision scans also report cache misses
+// per entity visited.
+#define GL_SILENCE_DEPRECATION
+
+#ifdef _WINDOWS
+#include <GL/glew.h>
+#endif
+
+#define GL_GLEXT_PROTOTYPES 1
+#include <SDL.h>
+#include <SDL_opengl.h>
+#include "glm/mat4x4.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "ShaderProgram.h"
+#include "Entity.h"
+#include "EntityStore.h"
+#include "EntityPool.h"
+#include "Render.h"
+#include "Simulation.h"
+#include "FixedSim.h"
+#include "LanderBatch.h"
+#include "UniformGrid.h"
+#include "StaticBvh.h"
+#include "SweepAndPrune.h"
+#include "AabbKernel.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+constexpr int WINDOW_WIDTH = 640,
+              WINDOW_HEIGHT = 480;
+
+constexpr char V_SHADER_PATH[] = "shaders/vertex.glsl",
+               F_SHADER_PATH[] = "shaders/fragment.glsl",
+               FONT_FILEPATH[] = "font2.png";
+
+constexpr int ENTITY_COUNTS[] = { 16, 128, 1024, 8192 };
+constexpr int BATCH_SIZE = 256;
+constexpr int TICKS_PER_ITERATION = 1024;
+constexpr int FRAMES_PER_RESET = 60; // Entity::update frames between putting the movers back
+
+double g_min_seconds = 0.5;          // Each benchmark repeats its body for at least this long
+unsigned long long g_sink = 0;       // Results are folded in here so nothing gets optimised away
+
+// ————— HARNESS ————— //
+// Runs body until g_min_seconds have passed and prints one JSON line. ops_per_iteration
+// is how many of the measured operations one call of body performs; extra_fields is
+// appended to the line as-is.
+template <typename Body>
+void run_benchmark(const char* name, const char* parameter, long long value, long long ops_per_iteration, Body body,
+                   const std::string& extra_fields = "")
+{
+    typedef std::chrono::steady_clock Clock;
+
+    body(); // Warm caches and branch predictors
+
+    long long iterations = 0;
+    double seconds = 0.0;
+    Clock::time_point start = Clock::now();
+    do {
+        body();
+        iterations++;
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (seconds < g_min_seconds);
+
+    double ops = (double)iterations * (double)ops_per_iteration;
+    std::printf("{\"benchmark\":\"%s\"", name);
+    if (parameter) std::printf(",\"%s\":%lld", parameter, value);
+    std::printf(",\"iterations\":%lld,\"ns_per_op\":%.3f,\"ops_per_sec\":%.1f%s}\n",
+                iterations, seconds * 1e9 / ops, ops / seconds, extra_fields.c_str());
+    std::fflush(stdout);
+}
+
+void report_skipped(const char* name, const char* reason)
+{
+    std::printf("{\"benchmark\":\"%s\",\"skipped\":\"%s\"}\n", name, reason);
+    std::fflush(stdout);
+}
+
+// ————— CACHE COUNTERS ————— //
+// L1 data and last-level cache misses on this thread, from Linux perf events. On other
+// systems, or where perf is missing or locked down, count_cache_misses() returns false.
+struct CacheMisses
+{
+    long long l1d, llc;
+};
+
+#ifdef __linux__
+int open_cache_counter(unsigned type, unsigned long long config)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+// Runs body once with the counters on
+template <typename Body>
+bool count_cache_misses(Body body, CacheMisses& misses)
+{
+#ifdef __linux__
+    const unsigned long long l1d_read_misses = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    int counters[2] = { open_cache_counter(PERF_TYPE_HW_CACHE, l1d_read_misses),
+                        open_cache_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES) };
+    long long* results[2] = { &misses.l1d, &misses.llc };
+
+    bool counted = counters[0] >= 0 && counters[1] >= 0;
+    if (counted) {
+        for (int counter : counters) ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        for (int counter : counters) ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+        body();
+        for (int counter : counters) ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+
+        for (int i = 0; i < 2; i++) {
+            counted = counted && read(counters[i], results[i], sizeof(long long)) == (ssize_t)sizeof(long long);
+        }
+    }
+    for (int counter : counters) {
+        if (counter >= 0) close(counter);
+    }
+    return counted;
+#else
+    (void)body;
+    (void)misses;
+    return false;
+#endif
+}
+
+// A fixed control pattern that both burns fuel and drifts sideways
+unsigned scripted_input(unsigned tick)
+{
+    unsigned input = (tick / 37) % 3 == 0 ? INPUT_THRUST : INPUT_NONE;
+    input |= (tick / 53) % 2 ? INPUT_LEFT : INPUT_RIGHT;
+    return input;
+}
+
+// Lays count unit boxes out on a grid around the origin, close enough that a
+// mover in the middle touches a few of them
+std::vector<Entity> make_blocks(int count, EntityType type)
+{
+    std::vector<Entity> blocks(count);
+    int columns = 1;
+    while (columns * columns < count) columns++;
+
+    for (int i = 0; i < count; i++) {
+        blocks[i].set_position(glm::vec3((float)(i % columns - columns / 2) * 1.5f,
+                                         (float)(i / columns - columns / 2) * 1.5f, 0.0f));
+        blocks[i].set_width(1.0f);
+        blocks[i].set_height(1.0f);
+        blocks[i].set_entity_type(type);
+    }
+    return blocks;
+}
+
+// ————— SIMULATION ————— //
+void bench_simulation()
+{
+    // The fixed-timestep loop update() drives, one scripted episode after another
+    SimState state;
+    sim_init(state, 1);
+    run_benchmark("update_ticks", nullptr, 0, TICKS_PER_ITERATION, [&]()
+    {
+        for (int t = 0; t < TICKS_PER_ITERATION; t++) {
+            if (state.game_over) sim_reset(state);
+            sim_step(state, scripted_input(state.tick));
+        }
+        g_sink += state.tick;
+    });
+
+    // The same episodes in Q16.16 fixed point
+    FixedSimState fixed;
+    fixed_sim_init(fixed, 1);
+    run_benchmark("fixed_update_ticks", nullptr, 0, TICKS_PER_ITERATION, [&]()
+    {
+        for (int t = 0; t < TICKS_PER_ITERATION; t++) {
+            if (fixed.game_over) fixed_sim_reset(fixed);
+            fixed_sim_step(fixed, scripted_input(fixed.tick));
+        }
+        g_sink += fixed.tick;
+    });
+
+    // The same episodes in coarse swept steps, still counted in FIXED_TIMESTEP ticks
+    for (int ticks_per_step : { 4, 8 })
+    {
+        SimState swept;
+        sim_init(swept, 1);
+        run_benchmark("swept_ticks", "ticks_per_step", ticks_per_step, TICKS_PER_ITERATION, [&]()
+        {
+            unsigned end_tick = swept.tick + TICKS_PER_ITERATION;
+            while (swept.tick < end_tick) {
+                if (swept.game_over) { end_tick -= swept.tick; sim_reset(swept); }
+                sim_step_swept(swept, scripted_input(swept.tick), ticks_per_step);
+            }
+            g_sink += swept.tick;
+        });
+    }
+
+    // Coarse steps that halve themselves near anything, down to single ticks
+    for (int ticks_per_step : { 8, 32 })
+    {
+        SimState adaptive;
+        sim_init(adaptive, 1);
+        SimSubstepCounters substeps = {};
+        run_benchmark("adaptive_ticks", "ticks_per_step", ticks_per_step, TICKS_PER_ITERATION, [&]()
+        {
+            unsigned end_tick = adaptive.tick + TICKS_PER_ITERATION;
+            while (adaptive.tick < end_tick) {
+                if (adaptive.game_over) { end_tick -= adaptive.tick; sim_reset(adaptive); }
+                sim_step_adaptive(adaptive, scripted_input(adaptive.tick), ticks_per_step, substeps);
+            }
+            g_sink += adaptive.tick + substeps.fine_ticks;
+        });
+    }
+
+    // Mostly free fall: short thrust bursts between long coasts, as runs of held input,
+    // stepped tick by tick and then through sim_step_held
+    for (int held : { 0, 1 })
+    {
+        SimState coasting;
+        sim_init(coasting, 1);
+        unsigned run = 0;
+        run_benchmark("coast_ticks", "held", held, TICKS_PER_ITERATION, [&]()
+        {
+            unsigned end_tick = coasting.tick + TICKS_PER_ITERATION;
+            while (coasting.tick < end_tick) {
+                if (coasting.game_over) { end_tick -= coasting.tick; sim_reset(coasting); }
+
+                unsigned input = run % 2 ? INPUT_THRUST : INPUT_NONE;
+                unsigned length = std::min(run % 2 ? 20u : 120u, end_tick - coasting.tick);
+                if (held) sim_step_held(coasting, input, length);
+                else for (unsigned t = 0; t < length && !coasting.game_over; t++) sim_step(coasting, input);
+                run++;
+            }
+            g_sink += coasting.tick;
+        });
+    }
+
+    LanderBatch batch(BATCH_SIZE);
+    batch.init(1);
+    std::vector<unsigned char> inputs(BATCH_SIZE);
+    unsigned tick = 0;
+    run_benchmark("batch_ticks", "landers", BATCH_SIZE, (long long)BATCH_SIZE * 64, [&]()
+    {
+        for (int t = 0; t < 64; t++, tick++) {
+            for (int i = 0; i < BATCH_SIZE; i++) inputs[i] = (unsigned char)scripted_input(tick + i);
+            batch.step(inputs.data());
+        }
+        if (tick % 4096 == 0) batch.reset_all();
+        g_sink += (unsigned)batch.get_status()[0];
+    });
+
+    // The hull test sim_step runs against every box in the level, leaning and close
+    // enough to the platforms that the edge axes are needed
+    SimState level;
+    sim_init(level, 1);
+    glm::vec3 hull_position(-4.2f, -2.95f, 0.0f);
+    run_benchmark("hull_collision", nullptr, 0, PLATFORM_COUNT + ASTEROID_COUNT, [&]()
+    {
+        unsigned hits = 0;
+        for (int i = 0; i < PLATFORM_COUNT; i++) hits += sim_check_hull_collision(hull_position, LANDER_TILT, level.platforms[i]);
+        for (int i = 0; i < ASTEROID_COUNT; i++) hits += sim_check_hull_collision(hull_position, LANDER_TILT, level.asteroids[i]);
+        g_sink += hits;
+    });
+}
+
+// ————— COLLISIONS ————— //
+void bench_collisions()
+{
+    for (int count : ENTITY_COUNTS)
+    {
+        std::vector<Entity> blocks = make_blocks(count, PLATFORM);
+        Entity mover;
+        mover.set_width(1.0f);
+        mover.set_height(1.0f);
+
+        run_benchmark("check_collision", "entities", count, count, [&]()
+        {
+            unsigned hits = 0;
+            for (int i = 0; i < count; i++) hits += mover.check_collision(&blocks[i]);
+            g_sink += hits;
+        });
+
+        // The resolvers push the mover out of whatever it overlaps, so it goes back each time
+        run_benchmark("check_collision_y", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(0.0f, -1.0f, 0.0f));
+            mover.check_collision_y(blocks.data(), count);
+            g_sink += mover.get_collided_bottom();
+        });
+
+        run_benchmark("check_collision_x", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(1.0f, 0.0f, 0.0f));
+            mover.check_collision_x(blocks.data(), count);
+            g_sink += mover.get_collided_right();
+        });
+
+        // The same tests on packed copies, a register's worth of boxes at a time
+        PackedColliders colliders;
+        for (const Entity& block : blocks) colliders.add(block.get_position(), block.get_width(), block.get_height());
+        std::vector<std::uint32_t> masks(aabb_mask_words(count));
+
+        run_benchmark("check_collision_simd", "entities", count, count, [&]()
+        {
+            colliders.overlap_masks(mover.get_position(), mover.get_width(), mover.get_height(), 0, masks.data());
+            g_sink += masks[0];
+        });
+
+        run_benchmark("check_collision_y_simd", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(0.0f, -1.0f, 0.0f));
+            mover.check_collision_y(blocks.data(), colliders);
+            g_sink += mover.get_collided_bottom();
+        });
+
+        run_benchmark("check_collision_x_simd", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(1.0f, 0.0f, 0.0f));
+            mover.check_collision_x(blocks.data(), colliders);
+            g_sink += mover.get_collided_right();
+        });
+
+        // Same resolvers through the uniform-grid broadphase; ops are still entities in the level
+        UniformGrid grid(2.0f);
+        for (const Entity& block : blocks) grid.add_static(block.get_position(), block.get_width(), block.get_height());
+        grid.build_static();
+
+        run_benchmark("check_collision_y_grid", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(0.0f, -1.0f, 0.0f));
+            mover.check_collision_y(blocks.data(), grid);
+            g_sink += mover.get_collided_bottom();
+        });
+
+        run_benchmark("check_collision_x_grid", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(1.0f, 0.0f, 0.0f));
+            mover.check_collision_x(blocks.data(), grid);
+            g_sink += mover.get_collided_right();
+        });
+
+        // And through the static BVH
+        StaticBvh level;
+        for (const Entity& block : blocks) level.add(block.get_position(), block.get_width(), block.get_height());
+        level.build();
+
+        run_benchmark("check_collision_y_bvh", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(0.0f, -1.0f, 0.0f));
+            mover.check_collision_y(blocks.data(), level);
+            g_sink += mover.get_collided_bottom();
+        });
+
+        run_benchmark("check_collision_x_bvh", "entities", count, count, [&]()
+        {
+            mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+            mover.set_velocity(glm::vec3(1.0f, 0.0f, 0.0f));
+            mover.check_collision_x(blocks.data(), level);
+            g_sink += mover.get_collided_right();
+        });
+
+        // First contact along a path threading between the blocks, one box at a time and through the BVH
+        std::vector<SimBox> boxes(count);
+        for (int i = 0; i < count; i++) boxes[i] = SimBox{ blocks[i].get_position(), blocks[i].get_width(), blocks[i].get_height() };
+        glm::vec3 sweep_start(0.75f, 0.75f, 0.0f), sweep_end(40.75f, 1.0f, 0.0f);
+
+        run_benchmark("sweep_linear", "entities", count, count, [&]()
+        {
+            float first = 2.0f, time;
+            for (const SimBox& box : boxes) {
+                if (sim_sweep_collision(sweep_start, sweep_end, 0.25f, 0.25f, box, time)) first = std::min(first, time);
+            }
+            g_sink += (unsigned)(first * 1000.0f);
+        });
+
+        run_benchmark("sweep_bvh", "entities", count, count, [&]()
+        {
+            BvhHit hit;
+            g_sink += level.sweep(sweep_start, sweep_end, 0.25f, 0.25f, hit) ? (unsigned)hit.index : 0u;
+        });
+
+        run_benchmark("raycast_bvh", "entities", count, count, [&]()
+        {
+            BvhHit hit;
+            g_sink += level.raycast(sweep_start, glm::vec3(1.0f, 0.01f, 0.0f), 1000.0f, hit) ? (unsigned)hit.index : 0u;
+        });
+    }
+}
+
+// ————— COLLISION SCANS ————— //
+// Entity's members in the order they had before the hot/cold split: 288 bytes on x64,
+// with the position at byte 92 and the extents and layers at 252-268, so a collision
+// scan touched two cache lines per entity. Kept so the scans below can show what the
+// split saves; only what a scan reads is ever set.
+struct LegacyEntity
+{
+    bool m_is_active;
+    int  m_walking[4][4];
+
+    EntityType m_entity_type;
+    AIType     m_ai_type;
+    AIState    m_ai_state;
+
+    glm::vec3 m_movement;
+    glm::vec3 m_position;
+    glm::vec3 m_scale;
+    glm::vec3 m_velocity;
+    glm::vec3 m_acceleration;
+
+    glm::mat4 m_model_matrix;
+
+    float m_speed,
+          m_jumping_power;
+    bool  m_is_jumping;
+
+    GLuint m_texture_id;
+
+    int m_animation_cols;
+    int m_animation_frames,
+        m_animation_index,
+        m_animation_rows;
+    int*  m_animation_indices;
+    float m_animation_time;
+
+    float m_width,
+          m_height;
+    unsigned m_collision_category,
+             m_collision_mask;
+
+    bool m_collided_top,
+         m_collided_bottom,
+         m_collided_left,
+         m_collided_right;
+
+    ContactList* m_contacts;
+    int          m_contact_index;
+
+    // The getters a scan reads through, as Entity has them
+    glm::vec3 get_position() const { return m_position; }
+    float get_width() const { return m_width; }
+    float get_height() const { return m_height; }
+    unsigned get_collision_category() const { return m_collision_category; }
+    unsigned get_collision_mask() const { return m_collision_mask; }
+};
+
+static_assert(sizeof(void*) != 8 || sizeof(LegacyEntity) == 288, "LegacyEntity must keep Entity's old layout");
+
+// The same level as make_blocks, in the old layout
+std::vector<LegacyEntity> make_legacy_blocks(const std::vector<Entity>& blocks)
+{
+    std::vector<LegacyEntity> legacy_blocks(blocks.size(), LegacyEntity());
+    for (size_t i = 0; i < blocks.size(); i++) {
+        legacy_blocks[i].m_position = blocks[i].get_position();
+        legacy_blocks[i].m_width = blocks[i].get_width();
+        legacy_blocks[i].m_height = blocks[i].get_height();
+        legacy_blocks[i].m_collision_category = blocks[i].get_collision_category();
+        legacy_blocks[i].m_collision_mask = blocks[i].get_collision_mask();
+    }
+    return legacy_blocks;
+}
+
+// check_collision_y's broad tests, the layers and then the overlap, of a unit mover at
+// the origin against every entity, in array order or in the order given. One body for
+// both layouts, so only where the fields sit differs between them.
+template <typename E>
+unsigned scan_overlaps(const E* entities, const int* order, int count)
+{
+    const glm::vec3 position(0.2f, 0.2f, 0.0f);
+    unsigned hits = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        const E& other = entities[order ? order[i] : i];
+        if (!layers_collide(LAYER_ALL, LAYER_ALL, other.get_collision_category(), other.get_collision_mask())) continue;
+
+        glm::vec3 other_position = other.get_position();
+        float x_distance = std::fabs(position.x - other_position.x) - ((1.0f + other.get_width()) / 2.0f);
+        float y_distance = std::fabs(position.y - other_position.y) - ((1.0f + other.get_height()) / 2.0f);
+        hits += x_distance < 0.0f && y_distance < 0.0f;
+    }
+    return hits;
+}
+
+// Times one layout's scan, with its cache misses per entity visited where the counters
+// can be read
+template <typename Scan>
+void run_collision_scan(const char* layout, const char* order, int count, int entity_bytes, Scan scan)
+{
+    const int counted_scans = 4;
+    CacheMisses misses;
+    char extra[224];
+    int length = std::snprintf(extra, sizeof(extra), ",\"layout\":\"%s\",\"order\":\"%s\",\"entity_bytes\":%d,\"level_mib\":%.1f",
+                               layout, order, entity_bytes, (double)entity_bytes * count / (1024.0 * 1024.0));
+
+    scan(); // Counted from the same warm start the timed runs get
+    if (count_cache_misses([&]() { for (int i = 0; i < counted_scans; i++) scan(); }, misses)) {
+        double visited = (double)counted_scans * count;
+        std::snprintf(extra + length, sizeof(extra) - length, ",\"l1d_misses_per_op\":%.3f,\"llc_misses_per_op\":%.3f",
+                      misses.l1d / visited, misses.llc / visited);
+    }
+    else {
+        std::snprintf(extra + length, sizeof(extra) - length, ",\"cache_misses\":\"unavailable\"");
+    }
+
+    run_benchmark("collision_scan", "entities", count, count, scan, extra);
+}
+
+void bench_collision_scans()
+{
+    // The current layout against the old one, from a level that fits in L2 to ones far
+    // bigger than any last-level cache. In array order the prefetcher streams in every
+    // line whatever the layout; in a random order, as a broadphase's candidates come,
+    // each entity costs the lines its collision data sits on.
+    const int level_sizes[] = { 8192, 131072, 1048576, 4194304 };
+
+    for (int count : level_sizes)
+    {
+        std::vector<int> order(count);
+        for (int i = 0; i < count; i++) order[i] = i;
+        std::shuffle(order.begin(), order.end(), std::mt19937(count));
+
+        std::vector<Entity> blocks = make_blocks(count, PLATFORM);
+        run_collision_scan("hot_cold", "sequential", count, (int)sizeof(Entity), [&]()
+        {
+            g_sink += scan_overlaps(blocks.data(), nullptr, count);
+        });
+        run_collision_scan("hot_cold", "scattered", count, (int)sizeof(Entity), [&]()
+        {
+            g_sink += scan_overlaps(blocks.data(), order.data(), count);
+        });
+
+        // Only one level's worth of either layout is held at a time
+        std::vector<LegacyEntity> legacy_blocks = make_legacy_blocks(blocks);
+        std::vector<Entity>().swap(blocks);
+
+        run_collision_scan("legacy", "sequential", count, (int)sizeof(LegacyEntity), [&]()
+        {
+            g_sink += scan_overlaps(legacy_blocks.data(), nullptr, count);
+        });
+        run_collision_scan("legacy", "scattered", count, (int)sizeof(LegacyEntity), [&]()
+        {
+            g_sink += scan_overlaps(legacy_blocks.data(), order.data(), count);
+        });
+    }
+}
+
+// ————— ENTITY UPDATE ————— //
+void bench_entity_update()
+{
+    std::vector<Entity> platforms = make_blocks(16, PLATFORM);
+
+    Entity player;
+    player.set_position(glm::vec3(0.0f, 2.0f, 0.0f));
+    player.set_entity_type(PLAYER);
+
+    for (int count : ENTITY_COUNTS)
+    {
+        // Half walkers, half guards, spread over the same area as the platforms
+        std::vector<Entity> enemies;
+        enemies.reserve(count);
+        for (int i = 0; i < count; i++) {
+            bool walker = i % 2 == 0;
+            enemies.emplace_back(0, 1.0f, 0.8f, 0.8f, ENEMY, walker ? WALKER : GUARD, walker ? WALKING : IDLE);
+            enemies.back().set_acceleration(glm::vec3(0.0f, -9.81f, 0.0f));
+            enemies.back().set_jumping_power(0.0f);
+        }
+
+        const float delta_time = (float)FIXED_TIMESTEP;
+        run_benchmark("entity_update_ai", "entities", count, (long long)count * FRAMES_PER_RESET, [&]()
+        {
+            for (int i = 0; i < count; i++) {
+                enemies[i].set_position(glm::vec3((float)(i % 64) * 0.1f - 3.2f, 1.0f + (float)(i / 64 % 8) * 0.3f, 0.0f));
+                enemies[i].set_velocity(glm::vec3(0.0f));
+                enemies[i].set_ai_state(i % 2 == 0 ? WALKING : IDLE);
+            }
+
+            for (int frame = 0; frame < FRAMES_PER_RESET; frame++) {
+                for (int i = 0; i < count; i++) {
+                    enemies[i].update(delta_time, &player, platforms.data(), (int)platforms.size());
+                }
+            }
+            g_sink += enemies[0].get_collided_bottom();
+        });
+
+        // The same frames as one batched pass per tick, through each integrator
+        const char* names[] = { "entity_update_euler", "entity_update_verlet", "entity_update_rk4" };
+        BodyBatch bodies;
+        for (int kind = 0; kind < 3; kind++)
+        {
+            run_benchmark(names[kind], "entities", count, (long long)count * FRAMES_PER_RESET, [&]()
+            {
+                for (int i = 0; i < count; i++) {
+                    enemies[i].set_position(glm::vec3((float)(i % 64) * 0.1f - 3.2f, 1.0f + (float)(i / 64 % 8) * 0.3f, 0.0f));
+                    enemies[i].set_velocity(glm::vec3(0.0f));
+                    enemies[i].set_ai_state(i % 2 == 0 ? WALKING : IDLE);
+                }
+
+                for (int frame = 0; frame < FRAMES_PER_RESET; frame++) {
+                    Entity::update_all(enemies.data(), count, bodies, (IntegratorKind)kind, delta_time,
+                                       &player, platforms.data(), (int)platforms.size());
+                }
+                g_sink += enemies[0].get_collided_bottom();
+            });
+        }
+    }
+}
+
+// ————— ENTITY STORE ————— //
+void bench_entity_store()
+{
+    for (int count : ENTITY_COUNTS)
+    {
+        // The level as the game used to keep it, one heap Entity per box, against the
+        // same boxes in an EntityStore
+        std::vector<Entity> blocks = make_blocks(count, PLATFORM);
+        std::vector<Entity*> heap;
+        EntityStore store;
+        for (const Entity& block : blocks) {
+            heap.push_back(new Entity(block));
+            store.add(PLATFORM, block.get_position(), block.get_width(), block.get_height());
+        }
+
+        Entity mover;
+        mover.set_position(glm::vec3(0.2f, 0.2f, 0.0f));
+        mover.set_width(1.0f);
+        mover.set_height(1.0f);
+
+        run_benchmark("level_scan_heap", "entities", count, count, [&]()
+        {
+            unsigned hits = 0;
+            for (Entity* block : heap) hits += mover.check_collision(block);
+            g_sink += hits;
+        });
+
+        std::vector<int> hits;
+        run_benchmark("level_scan_store", "entities", count, count, [&]()
+        {
+            store.query_box(mover.get_position(), mover.get_width(), mover.get_height(), LAYER_ALL, LAYER_ALL, hits);
+            g_sink += hits.size();
+        });
+
+        // Moving every box, as the physics system does for a level that isn't static
+        for (int i = 0; i < count; i++) store.set_velocity(i, glm::vec3(i % 2 ? 0.5f : -0.5f, 0.0f, 0.0f));
+        run_benchmark("level_integrate_store", "entities", count, count, [&]()
+        {
+            store.integrate(INTEGRATOR_SEMI_IMPLICIT_EULER, (float)FIXED_TIMESTEP);
+            g_sink += (unsigned long long)store.get_position(0).x;
+        });
+
+        for (Entity* block : heap) delete block;
+    }
+}
+
+// ————— ENTITY POOL ————— //
+void bench_entity_pool()
+{
+    for (int count : ENTITY_COUNTS)
+    {
+        // count enemies alive throughout, each one despawned and a new one spawned in
+        // its place per op, as in a level where enemies keep dying and respawning.
+        // The order they go in is scrambled so the free list isn't simply a stack.
+        std::vector<int> order(count);
+        for (int i = 0; i < count; i++) order[i] = (int)(((unsigned)i * 2654435761u) % (unsigned)count);
+
+        std::vector<Entity*> heap(count);
+        for (int i = 0; i < count; i++) heap[i] = new Entity(0, 1.0f, 0.8f, 0.8f, ENEMY, WALKER, WALKING);
+
+        run_benchmark("entity_respawn_heap", "entities", count, count, [&]()
+        {
+            for (int i : order) {
+                delete heap[i];
+                heap[i] = new Entity(0, 1.0f, 0.8f, 0.8f, ENEMY, WALKER, WALKING);
+            }
+            g_sink += heap[0]->get_entity_type();
+        });
+        for (Entity* enemy : heap) delete enemy;
+
+        EntityPool pool(count);
+        std::vector<EntityHandle> handles(count);
+        for (int i = 0; i < count; i++) handles[i] = pool.spawn(0, 1.0f, 0.8f, 0.8f, ENEMY, WALKER, WALKING);
+
+        run_benchmark("entity_respawn_pool", "entities", count, count, [&]()
+        {
+            for (int i : order) {
+                pool.destroy(handles[i]);
+                handles[i] = pool.spawn(0, 1.0f, 0.8f, 0.8f, ENEMY, WALKER, WALKING);
+            }
+            g_sink += pool.get(handles[0])->get_entity_type();
+        });
+
+        // What a handle costs over a pointer: the generation check on every lookup
+        run_benchmark("entity_handle_get", "entities", count, count, [&]()
+        {
+            float x = 0.0f;
+            for (EntityHandle handle : handles) x += pool.get(handle)->get_position().x;
+            g_sink += (unsigned long long)x;
+        });
+    }
+}
+
+// ————— ENEMY PAIRS ————— //
+void bench_enemy_pairs()
+{
+    for (int count : ENTITY_COUNTS)
+    {
+        // Enemies drifting a little every tick, about as densely packed as a busy level
+        std::vector<glm::vec3> positions(count);
+        std::vector<glm::vec3> velocities(count);
+        int columns = 1;
+        while (columns * columns < count) columns++;
+        for (int i = 0; i < count; i++) {
+            positions[i] = glm::vec3((float)(i % columns) * 1.2f, (float)(i / columns) * 1.2f, 0.0f);
+            velocities[i] = glm::vec3(i % 2 ? 1.0f : -1.0f, i % 3 ? 0.5f : -0.5f, 0.0f);
+        }
+
+        auto drift = [&]()
+        {
+            for (int i = 0; i < count; i++) {
+                positions[i] += velocities[i] * (float)FIXED_TIMESTEP;
+                if (positions[i].x < 0.0f || positions[i].x > columns * 1.2f) velocities[i].x = -velocities[i].x;
+                if (positions[i].y < 0.0f || positions[i].y > columns * 1.2f) velocities[i].y = -velocities[i].y;
+            }
+        };
+
+        SweepAndPrune sweep;
+        for (int i = 0; i < count; i++) sweep.add(positions[i], 1.0f, 1.0f);
+        std::vector<OverlapPair> pairs;
+
+        run_benchmark("enemy_pairs_sap", "entities", count, 1, [&]()
+        {
+            drift();
+            for (int i = 0; i < count; i++) sweep.move(i, positions[i], 1.0f, 1.0f);
+            sweep.find_pairs(pairs);
+            g_sink += pairs.size();
+        });
+
+        // The quadratic check it replaces; skipped where it would take minutes
+        if (count > 1024) continue;
+        std::vector<Entity> enemies = make_blocks(count, ENEMY);
+        run_benchmark("enemy_pairs_all", "entities", count, 1, [&]()
+        {
+            drift();
+            for (int i = 0; i < count; i++) enemies[i].set_position(positions[i]);
+
+            unsigned found = 0;
+            for (int i = 0; i < count; i++)
+                for (int j = i + 1; j < count; j++) found += enemies[i].check_collision(&enemies[j]);
+            g_sink += found;
+        });
+    }
+}
+
+// ————— MIXED SCENE ————— //
+void bench_mixed_pairs()
+{
+    for (int count : ENTITY_COUNTS)
+    {
+        // Mostly enemies, an eighth platforms (which stay put) and the odd player, packed
+        // as in bench_enemy_pairs; most overlapping pairs are enemy on enemy
+        std::vector<glm::vec3> positions(count);
+        std::vector<glm::vec3> velocities(count);
+        std::vector<EntityType> types(count);
+        int columns = 1;
+        while (columns * columns < count) columns++;
+        for (int i = 0; i < count; i++) {
+            types[i] = i % 8 == 0 ? PLATFORM : i % 64 == 1 ? PLAYER : ENEMY;
+            positions[i] = glm::vec3((float)(i % columns) * 0.9f, (float)(i / columns) * 0.9f, 0.0f);
+            velocities[i] = types[i] == PLATFORM ? glm::vec3(0.0f)
+                                                 : glm::vec3(i % 2 ? 1.0f : -1.0f, i % 3 ? 0.5f : -0.5f, 0.0f);
+        }
+
+        for (int layered : { 0, 1 })
+        {
+            std::vector<glm::vec3> moved = positions;
+            std::vector<glm::vec3> moving = velocities;
+            SweepAndPrune sweep;
+            for (int i = 0; i < count; i++) {
+                if (layered) sweep.add(moved[i], 1.0f, 1.0f, collision_category(types[i]), collision_mask(types[i]));
+                else         sweep.add(moved[i], 1.0f, 1.0f);
+            }
+            std::vector<OverlapPair> pairs;
+
+            run_benchmark(layered ? "mixed_pairs_sap_layers" : "mixed_pairs_sap", "entities", count, 1, [&]()
+            {
+                for (int i = 0; i < count; i++) {
+                    moved[i] += moving[i] * (float)FIXED_TIMESTEP;
+                    if (moved[i].x < 0.0f || moved[i].x > columns * 0.9f) moving[i].x = -moving[i].x;
+                    if (moved[i].y < 0.0f || moved[i].y > columns * 0.9f) moving[i].y = -moving[i].y;
+                    sweep.move(i, moved[i], 1.0f, 1.0f);
+                }
+                sweep.find_pairs(pairs);
+                g_sink += pairs.size();
+            });
+        }
+    }
+}
+
+// ————— TEXT ————— //
+void bench_text()
+{
+    const std::string messages[] = { "MISSION FAILED", "MISSION ACCOMPLISHED",
+                                     "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789" };
+
+    for (const std::string& message : messages)
+    {
+        run_benchmark("build_text_mesh", "characters", (long long)message.size(), 1, [&]()
+        {
+            // Fresh buffers per call, exactly as draw_text builds them every frame
+            std::vector<float> vertices;
+            std::vector<float> texture_coordinates;
+            build_text_mesh(message, 0.5f, 0.05f, vertices, texture_coordinates);
+            g_sink += vertices.size();
+        });
+    }
+}
+
+// ————— RENDERING ————— //
+void bench_render(bool software)
+{
+    if (software) {
+        SDL_setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+        SDL_setenv("GALLIUM_DRIVER", "llvmpipe", 1);
+    }
+
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) {
+        report_skipped("render_frame", "SDL video could not be initialised");
+        return;
+    }
+
+    SDL_Window* window = SDL_CreateWindow("Lunar Lander Benchmark",
+        SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+        WINDOW_WIDTH, WINDOW_HEIGHT,
+        SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    SDL_GLContext context = window ? SDL_GL_CreateContext(window) : nullptr;
+
+    if (context == nullptr) {
+        report_skipped("render_frame", "no OpenGL context");
+        if (window) SDL_DestroyWindow(window);
+        SDL_Quit();
+        return;
+    }
+
+    SDL_GL_MakeCurrent(window, context);
+    SDL_GL_SetSwapInterval(0); // Never wait on the display
+
+#ifdef _WINDOWS
+    glewInit();
+#endif
+
+    // Same setup as initialise() in the game
+    glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    ShaderProgram program;
+    program.load(V_SHADER_PATH, F_SHADER_PATH);
+    program.set_projection_matrix(glm::ortho(-5.0f, 5.0f, -3.75f, 3.75f, -1.0f, 1.0f));
+    program.set_view_matrix(glm::mat4(1.0f));
+
+    GLuint font_texture_id = load_texture(FONT_FILEPATH);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glClearColor(0.0f, 0.1f, 0.2f, 1.0f);
+
+    SimState state;
+    sim_init(state, 1);
+    state.game_over = true;
+    state.status = MISSION_ACCOMPLISHED;
+
+    // Reported alongside the timing, since it decides what was actually measured
+    std::string driver = ",\"renderer\":\"";
+    driver += (const char*)glGetString(GL_RENDERER);
+    driver += software ? "\",\"software\":true" : "\",\"software\":false";
+
+    // One full frame of render(), finished before the clock is read again
+    run_benchmark("render_frame", "width", WINDOW_WIDTH, 1, [&]()
+    {
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        for (int i = 0; i < PLATFORM_COUNT; i++) {
+            draw_platform(&program, state.platforms[i].position, state.platforms[i].width,
+                          state.platforms[i].height, i == LANDING_ZONE);
+        }
+        for (int i = 0; i < ASTEROID_COUNT; i++) {
+            draw_asteroid(&program, state.asteroids[i].position, state.asteroids[i].width);
+        }
+        draw_lander(&program, state.position, state.rotation);
+        draw_fuel_gauge(&program, state.fuel);
+
+        program.set_colour(1.0f, 1.0f, 1.0f, 1.0f);
+        draw_text(&program, font_texture_id, "MISSION ACCOMPLISHED", 0.5f, 0.05f, glm::vec3(-4.0f, 0.0f, 0.0f));
+
+        SDL_GL_SwapWindow(window);
+        glFinish();
+    }, driver);
+
+    SDL_GL_DeleteContext(context);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+}
+
+void print_usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--min-time SECONDS] [--no-render] [--hardware-gl]\n"
+              << "  --min-time SECONDS  shortest time each benchmark is repeated for (default 0.5)\n"
+              << "  --no-render         skip the render pass benchmark\n"
+              << "  --hardware-gl       render with the default driver instead of a software one\n";
+    exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+    bool render = true;
+    bool software = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (argument == "--min-time" && has_value) {
+            g_min_seconds = std::atof(argv[++i]);
+        }
+        else if (argument == "--no-render") {
+            render = false;
+        }
+        else if (argument == "--hardware-gl") {
+            software = false;
+        }
+        else {
+            print_usage(argv[0]);
+        }
+    }
+
+    bench_simulation();
+    bench_collisions();
+    bench_collision_scans();
+    bench_entity_update();
+    bench_entity_store();
+    bench_entity_pool();
+    bench_enemy_pairs();
+    bench_mixed_pairs();
+    bench_text();
+    if (render) bench_render(software);
+
+    return g_sink == 0xFFFFFFFFFFFFFFFFull ? 1 : 0;
+}
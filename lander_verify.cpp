@@ -0,0 +1,90 @@
+// Command-line front end for the determinism verifier: replays every given file and
+// reports the first tick at which two stepping paths, or two builds, went apart.
+#include "Verify.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+void print_usage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--workers N] [--save-traces DIR | --check-traces DIR | --swept K] [--fixed-point] REPLAY...\n"
+              << "  (default)          compare sim_step against LanderBatch for every replay\n"
+              << "  --save-traces DIR  write this build's per-tick hashes to DIR\n"
+              << "  --check-traces DIR compare this build's per-tick hashes with those saved in DIR\n"
+              << "  --swept K          compare sim_step_swept against sim_step, holding each action K ticks\n"
+              << "  --fixed-point      save or check traces of the fixed-point simulation\n"
+              << "  --workers N        threads to verify on (0 = one per hardware thread)\n";
+    exit(1);
+}
+
+int main(int argc, char* argv[])
+{
+    VerifyMode mode = VERIFY_SCALAR_VS_BATCH;
+    std::string trace_directory;
+    int worker_count = 0;
+    bool fixed_point = false;
+    int ticks_per_step = 1;
+    std::vector<std::string> replays;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (argument == "--workers" && has_value) {
+            worker_count = std::atoi(argv[++i]);
+        }
+        else if (argument == "--save-traces" && has_value) {
+            mode = VERIFY_SAVE_TRACES;
+            trace_directory = argv[++i];
+        }
+        else if (argument == "--check-traces" && has_value) {
+            mode = VERIFY_CHECK_TRACES;
+            trace_directory = argv[++i];
+        }
+        else if (argument == "--swept" && has_value) {
+            mode = VERIFY_SWEPT_VS_STEPPED;
+            ticks_per_step = std::atoi(argv[++i]);
+            if (ticks_per_step < 1) print_usage(argv[0]);
+        }
+        else if (argument == "--fixed-point") {
+            fixed_point = true;
+        }
+        else if (argument.size() > 1 && argument[0] == '-') {
+            print_usage(argv[0]);
+        }
+        else {
+            replays.push_back(argument);
+        }
+    }
+    if (replays.empty()) print_usage(argv[0]);
+
+    // There's no second fixed-point path to compare against within one build
+    if (fixed_point && (mode == VERIFY_SCALAR_VS_BATCH || mode == VERIFY_SWEPT_VS_STEPPED)) print_usage(argv[0]);
+
+    std::vector<VerifyResult> results = verify_replays(replays, mode, trace_directory, worker_count, fixed_point, ticks_per_step);
+
+    // One line per replay, so a failing run can be grepped for straight away
+    int failures = 0;
+    for (const VerifyResult& result : results)
+    {
+        if (!result.loaded) {
+            std::printf("%s: ERROR could not read replay or trace\n", result.replay.c_str());
+            failures++;
+        }
+        else if (mode == VERIFY_SAVE_TRACES) {
+            std::printf("%s: SAVED %u ticks\n", result.replay.c_str(), result.tick_count);
+        }
+        else if (result.divergence < 0) {
+            std::printf("%s: OK %u ticks\n", result.replay.c_str(), result.tick_count);
+        }
+        else {
+            std::printf("%s: DIVERGED at tick %lld (expected %016llx, got %016llx)\n",
+                        result.replay.c_str(), result.divergence,
+                        (unsigned long long)result.expected, (unsigned long long)result.actual);
+            failures++;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}